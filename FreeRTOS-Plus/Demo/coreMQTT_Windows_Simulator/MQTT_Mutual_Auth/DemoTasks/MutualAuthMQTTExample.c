@@ -256,6 +256,20 @@ extern void vLoggingPrintf( const char * pcFormatString,
  */
 #define mqttexampleINCOMING_PUBLISH_RECORD_LEN            ( 15U )
 
+/**
+ * @brief Set to 1 to send every other publish with the TLS connection corked
+ * and log how many TLS records and wire bytes each publish took, comparing
+ * TLS_FreeRTOS_Cork() batching against the default of one record per send.
+ */
+#ifndef mqttexampleCOMPARE_TLS_CORKING
+    #define mqttexampleCOMPARE_TLS_CORKING                ( 0 )
+#endif
+
+/**
+ * @brief Size of the buffer publishes are batched into while corked.
+ */
+#define mqttexampleCORK_BUFFER_SIZE                       ( 1024U )
+
 /**
  * Provide default values for undefined configuration settings.
  */
@@ -365,6 +379,22 @@ static void prvMQTTSubscribeWithBackoffRetries( MQTTContext_t * pxMQTTContext );
  */
 static void prvMQTTPublishToTopic( MQTTContext_t * pxMQTTContext );
 
+#if ( mqttexampleCOMPARE_TLS_CORKING == 1 )
+
+/**
+ * @brief Publishes a message with prvMQTTPublishToTopic(), optionally with the
+ * TLS connection corked, and logs the TLS records and bytes the publish took.
+ *
+ * @param[in] pxMQTTContext MQTT context pointer.
+ * @param[in] pxNetworkContext The network context of the MQTT connection.
+ * @param[in] xCorked pdTRUE to batch the publish into as few records as possible.
+ */
+    static void prvMQTTPublishAndCountRecords( MQTTContext_t * pxMQTTContext,
+                                               NetworkContext_t * pxNetworkContext,
+                                               BaseType_t xCorked );
+
+#endif
+
 /**
  * @brief Unsubscribes from the previously subscribed topic as specified
  * in mqttexampleTOPIC.
@@ -608,7 +638,13 @@ static void prvMQTTDemoTask( void * pvParameters )
         for( ulPublishCount = 0; ulPublishCount < ulMaxPublishCount; ulPublishCount++ )
         {
             LogInfo( ( "Publish to the MQTT topic %s.\r\n", mqttexampleTOPIC ) );
-            prvMQTTPublishToTopic( &xMQTTContext );
+            #if ( mqttexampleCOMPARE_TLS_CORKING == 1 )
+                prvMQTTPublishAndCountRecords( &xMQTTContext,
+                                               &xNetworkContext,
+                                               ( ( ulPublishCount % 2U ) == 1U ) ? pdTRUE : pdFALSE );
+            #else
+                prvMQTTPublishToTopic( &xMQTTContext );
+            #endif
 
             /* Process incoming publish echo, since application subscribed to the
              * same topic, the broker will send publish message back to the
@@ -1012,6 +1048,46 @@ static void prvMQTTPublishToTopic( MQTTContext_t * pxMQTTContext )
 }
 /*-----------------------------------------------------------*/
 
+#if ( mqttexampleCOMPARE_TLS_CORKING == 1 )
+
+    static void prvMQTTPublishAndCountRecords( MQTTContext_t * pxMQTTContext,
+                                               NetworkContext_t * pxNetworkContext,
+                                               BaseType_t xCorked )
+    {
+        static uint8_t ucCorkBuffer[ mqttexampleCORK_BUFFER_SIZE ];
+        uint32_t ulRecordsBefore, ulBytesBefore, ulRecordsAfter, ulBytesAfter;
+        TlsTransportStatus_t xStatus;
+
+        xStatus = TLS_FreeRTOS_GetSendStats( pxNetworkContext, &ulRecordsBefore, &ulBytesBefore );
+        configASSERT( xStatus == TLS_TRANSPORT_SUCCESS );
+
+        if( xCorked == pdTRUE )
+        {
+            xStatus = TLS_FreeRTOS_Cork( pxNetworkContext, ucCorkBuffer, sizeof( ucCorkBuffer ) );
+            configASSERT( xStatus == TLS_TRANSPORT_SUCCESS );
+        }
+
+        prvMQTTPublishToTopic( pxMQTTContext );
+
+        if( xCorked == pdTRUE )
+        {
+            /* Write the batched publish before waiting for its acknowledgment. */
+            xStatus = TLS_FreeRTOS_Uncork( pxNetworkContext );
+            configASSERT( xStatus == TLS_TRANSPORT_SUCCESS );
+        }
+
+        xStatus = TLS_FreeRTOS_GetSendStats( pxNetworkContext, &ulRecordsAfter, &ulBytesAfter );
+        configASSERT( xStatus == TLS_TRANSPORT_SUCCESS );
+
+        LogInfo( ( "Publish %s took %u TLS records, %u bytes on the wire.",
+                   ( xCorked == pdTRUE ) ? "corked" : "uncorked",
+                   ( unsigned ) ( ulRecordsAfter - ulRecordsBefore ),
+                   ( unsigned ) ( ulBytesAfter - ulBytesBefore ) ) );
+    }
+
+#endif /* if ( mqttexampleCOMPARE_TLS_CORKING == 1 ) */
+/*-----------------------------------------------------------*/
+
 static void prvMQTTUnsubscribeFromTopic( MQTTContext_t * pxMQTTContext )
 {
     MQTTStatus_t xResult;
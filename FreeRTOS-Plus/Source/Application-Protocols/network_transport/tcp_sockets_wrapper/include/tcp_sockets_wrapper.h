@@ -58,6 +58,32 @@
     typedef struct xSOCKET * Socket_t; /**< @brief Socket handle data type. */
 #endif
 
+/**
+ * @brief Time spent in each phase of a connection attempt.
+ */
+typedef struct TCP_Sockets_ConnectTimings
+{
+    TickType_t dnsTicks;       /**< @brief Ticks spent resolving the host name. */
+    TickType_t connectTicks;   /**< @brief Ticks spent establishing the TCP connection. */
+    TickType_t totalTicks;     /**< @brief Ticks from the start of the request to its completion. */
+    BaseType_t dnsCacheHit;    /**< @brief pdTRUE if the host name was served from the DNS cache, which is disabled by default. */
+    BaseType_t addressesTried; /**< @brief Number of resolved addresses a connection was attempted to. */
+} TCP_Sockets_ConnectTimings_t;
+
+/**
+ * @brief Callback invoked when a connection started with TCP_Sockets_ConnectAsync()
+ * completes.
+ *
+ * @param[in] connectStatus 0 on success, non-zero value on error.
+ * @param[in] tcpSocket The connected socket on success, otherwise NULL.
+ * @param[in] pTimings Time spent in each phase of the connection attempt.
+ * @param[in] pCallbackContext The context passed to TCP_Sockets_ConnectAsync().
+ */
+typedef void ( * TCP_Sockets_ConnectCallback_t )( BaseType_t connectStatus,
+                                                  Socket_t tcpSocket,
+                                                  const TCP_Sockets_ConnectTimings_t * pTimings,
+                                                  void * pCallbackContext );
+
 /**
  * @brief Establish a connection to server.
  *
@@ -68,6 +94,8 @@
  * @param[in] sendTimeoutMs Timeout (in milliseconds) for transport send.
  *
  * @note A timeout of 0 means infinite timeout.
+ * @note When the host name resolves to several addresses, the FreeRTOS+TCP port
+ * races connections to them as TCP_Sockets_ConnectAsync() does.
  *
  * @return Non-zero value on error, 0 on success.
  */
@@ -77,10 +105,45 @@ BaseType_t TCP_Sockets_Connect( Socket_t * pTcpSocket,
                                 uint32_t receiveTimeoutMs,
                                 uint32_t sendTimeoutMs );
 
+/**
+ * @brief Establish a connection to server without blocking the calling task.
+ *
+ * Host name resolution and connection establishment run in a background task.
+ * When the host name resolves to several addresses, connections to them are
+ * raced, preferring IPv6, and the first one to be established is kept.
+ * @p connectCallback is invoked from the background task once the connection
+ * is established or has failed.
+ *
+ * @param[in] pHostName Server hostname to connect to. It is copied, so it does
+ * not need to remain valid after this function returns.
+ * @param[in] port Server port to connect to.
+ * @param[in] receiveTimeoutMs Timeout (in milliseconds) for transport receive.
+ * @param[in] sendTimeoutMs Timeout (in milliseconds) for transport send.
+ * @param[in] connectCallback Callback to invoke on completion.
+ * @param[in] pCallbackContext Context passed to @p connectCallback.
+ *
+ * @note A timeout of 0 means infinite timeout.
+ * @note Only the FreeRTOS+TCP port implements this function, other ports
+ * return an error.
+ *
+ * @return 0 if the connection was started, non-zero value on error. On error
+ * @p connectCallback is not invoked.
+ */
+BaseType_t TCP_Sockets_ConnectAsync( const char * pHostName,
+                                     uint16_t port,
+                                     uint32_t receiveTimeoutMs,
+                                     uint32_t sendTimeoutMs,
+                                     TCP_Sockets_ConnectCallback_t connectCallback,
+                                     void * pCallbackContext );
+
 /**
  * @brief End connection to server.
  *
  * @param[in] tcpSocket The socket descriptor.
+ *
+ * @note How long the calling task waits for the peer to close the connection
+ * depends on the close policy of the port. The FreeRTOS+TCP port can bound the
+ * wait or hand the socket to a reaper task, see FREERTOS_SOCKETS_WRAPPER_CLOSE_POLICY.
  */
 void TCP_Sockets_Disconnect( Socket_t tcpSocket );
 
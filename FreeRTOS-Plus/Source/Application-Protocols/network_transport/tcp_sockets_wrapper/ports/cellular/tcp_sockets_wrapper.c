@@ -747,6 +747,28 @@ BaseType_t TCP_Sockets_Connect( Socket_t * pTcpSocket,
 
 /*-----------------------------------------------------------*/
 
+BaseType_t TCP_Sockets_ConnectAsync( const char * pHostName,
+                                     uint16_t port,
+                                     uint32_t receiveTimeoutMs,
+                                     uint32_t sendTimeoutMs,
+                                     TCP_Sockets_ConnectCallback_t connectCallback,
+                                     void * pCallbackContext )
+{
+    ( void ) pHostName;
+    ( void ) port;
+    ( void ) receiveTimeoutMs;
+    ( void ) sendTimeoutMs;
+    ( void ) connectCallback;
+    ( void ) pCallbackContext;
+
+    /* The modem resolves and connects in one step, use TCP_Sockets_Connect(). */
+    LogError( ( "TCP_Sockets_ConnectAsync is not supported by the cellular port." ) );
+
+    return TCP_SOCKETS_ERRNO_ERROR;
+}
+
+/*-----------------------------------------------------------*/
+
 void TCP_Sockets_Disconnect( Socket_t xSocket )
 {
     int32_t retClose = TCP_SOCKETS_ERRNO_NONE;
@@ -34,11 +34,14 @@
 
 /* FreeRTOS includes. */
 #include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
 
 /* FreeRTOS+TCP includes. */
 #include "FreeRTOS_IP.h"
 #include "FreeRTOS_Sockets.h"
 #include "FreeRTOS_DNS.h"
+#include "FreeRTOS_TCP_IP.h"
 
 /* Logging configuration for the Sockets. */
 #ifndef LIBRARY_LOG_NAME
@@ -68,87 +71,834 @@ extern void vLoggingPrintf( const char * pcFormatString,
     #define FREERTOS_SOCKETS_WRAPPER_SHUTDOWN_LOOPS    ( 3 )
 #endif
 
+/**
+ * @brief Close policies for TCP_Sockets_Disconnect().
+ *
+ * - FREERTOS_SOCKETS_WRAPPER_CLOSE_DRAIN: the calling task waits for the peer to
+ *   close the connection for up to FREERTOS_SOCKETS_WRAPPER_SHUTDOWN_LOOPS receive
+ *   timeouts of the socket.
+ * - FREERTOS_SOCKETS_WRAPPER_CLOSE_LINGER: the calling task waits for the peer to
+ *   close the connection for at most FREERTOS_SOCKETS_WRAPPER_LINGER_MS.
+ * - FREERTOS_SOCKETS_WRAPPER_CLOSE_REAPER: the socket is handed to a reaper task
+ *   that waits for the peer to close the connection for at most
+ *   FREERTOS_SOCKETS_WRAPPER_LINGER_MS, so the calling task does not block. When
+ *   the reaper cannot accept the socket the linger policy is applied instead.
+ */
+#define FREERTOS_SOCKETS_WRAPPER_CLOSE_DRAIN     ( 0 )
+#define FREERTOS_SOCKETS_WRAPPER_CLOSE_LINGER    ( 1 )
+#define FREERTOS_SOCKETS_WRAPPER_CLOSE_REAPER    ( 2 )
+
+/**
+ * @brief The close policy used by TCP_Sockets_Disconnect().
+ */
+#ifndef FREERTOS_SOCKETS_WRAPPER_CLOSE_POLICY
+    #define FREERTOS_SOCKETS_WRAPPER_CLOSE_POLICY    FREERTOS_SOCKETS_WRAPPER_CLOSE_DRAIN
+#endif
+
+/**
+ * @brief Maximum time (in milliseconds) to wait for the peer to close the
+ * connection with the linger and reaper close policies.
+ */
+#ifndef FREERTOS_SOCKETS_WRAPPER_LINGER_MS
+    #define FREERTOS_SOCKETS_WRAPPER_LINGER_MS    ( 1000U )
+#endif
+
+/**
+ * @brief Maximum number of sockets the reaper task closes at the same time.
+ */
+#ifndef FREERTOS_SOCKETS_WRAPPER_REAPER_QUEUE_LENGTH
+    #define FREERTOS_SOCKETS_WRAPPER_REAPER_QUEUE_LENGTH    ( 8 )
+#endif
+
+/**
+ * @brief Interval (in milliseconds) at which the reaper task polls the sockets it closes.
+ */
+#ifndef FREERTOS_SOCKETS_WRAPPER_REAPER_POLL_MS
+    #define FREERTOS_SOCKETS_WRAPPER_REAPER_POLL_MS    ( 50U )
+#endif
+
+/**
+ * @brief Stack size of the reaper task.
+ */
+#ifndef FREERTOS_SOCKETS_WRAPPER_REAPER_TASK_STACK_SIZE
+    #define FREERTOS_SOCKETS_WRAPPER_REAPER_TASK_STACK_SIZE    ( configMINIMAL_STACK_SIZE * 2 )
+#endif
+
+/**
+ * @brief Priority of the reaper task.
+ */
+#ifndef FREERTOS_SOCKETS_WRAPPER_REAPER_TASK_PRIORITY
+    #define FREERTOS_SOCKETS_WRAPPER_REAPER_TASK_PRIORITY    ( tskIDLE_PRIORITY + 1 )
+#endif
+
+#if ( FREERTOS_SOCKETS_WRAPPER_CLOSE_POLICY != FREERTOS_SOCKETS_WRAPPER_CLOSE_DRAIN ) && \
+    ( FREERTOS_SOCKETS_WRAPPER_CLOSE_POLICY != FREERTOS_SOCKETS_WRAPPER_CLOSE_LINGER ) &&  \
+    ( FREERTOS_SOCKETS_WRAPPER_CLOSE_POLICY != FREERTOS_SOCKETS_WRAPPER_CLOSE_REAPER )
+    #error FREERTOS_SOCKETS_WRAPPER_CLOSE_POLICY must be one of FREERTOS_SOCKETS_WRAPPER_CLOSE_DRAIN, FREERTOS_SOCKETS_WRAPPER_CLOSE_LINGER or FREERTOS_SOCKETS_WRAPPER_CLOSE_REAPER.
+#endif
+
+/**
+ * @brief Maximum number of resolved addresses a connection is attempted to.
+ */
+#ifndef FREERTOS_SOCKETS_WRAPPER_MAX_ADDRESSES
+    #define FREERTOS_SOCKETS_WRAPPER_MAX_ADDRESSES    ( 4 )
+#endif
+
+/**
+ * @brief Time (in milliseconds) a connection attempt is given before an attempt
+ * to the next resolved address is started in parallel.
+ */
+#ifndef FREERTOS_SOCKETS_WRAPPER_CONNECT_ATTEMPT_DELAY_MS
+    #define FREERTOS_SOCKETS_WRAPPER_CONNECT_ATTEMPT_DELAY_MS    ( 250U )
+#endif
+
+/**
+ * @brief Time (in ticks) after which raced connection attempts that are still
+ * in progress are abandoned.
+ *
+ * Defaults to the block time a single blocking FreeRTOS_connect() waits for, so
+ * racing several addresses does not change how long a connection may take.
+ */
+#ifndef FREERTOS_SOCKETS_WRAPPER_CONNECT_TIMEOUT_TICKS
+    #define FREERTOS_SOCKETS_WRAPPER_CONNECT_TIMEOUT_TICKS    ipconfigSOCK_DEFAULT_RECEIVE_BLOCK_TIME
+#endif
+
+/**
+ * @brief Interval (in milliseconds) at which connection attempts in progress are polled.
+ */
+#ifndef FREERTOS_SOCKETS_WRAPPER_CONNECT_POLL_MS
+    #define FREERTOS_SOCKETS_WRAPPER_CONNECT_POLL_MS    ( 10U )
+#endif
+
+/**
+ * @brief Number of host names kept in the DNS cache. 0, the default, disables
+ * the cache so that every connection resolves the host name again.
+ */
+#ifndef FREERTOS_SOCKETS_WRAPPER_DNS_CACHE_ENTRIES
+    #define FREERTOS_SOCKETS_WRAPPER_DNS_CACHE_ENTRIES    ( 0 )
+#endif
+
+/**
+ * @brief Time (in milliseconds) for which a DNS cache entry is used.
+ *
+ * The FreeRTOS+TCP DNS cache (ipconfigUSE_DNS_CACHE) honours the TTL of the DNS
+ * records themselves; this cache avoids repeating the lookups of every address
+ * family for host names that are connected to often.  It ignores the record TTL,
+ * so an entry is also dropped as soon as a connection to its addresses fails.
+ */
+#ifndef FREERTOS_SOCKETS_WRAPPER_DNS_CACHE_TTL_MS
+    #define FREERTOS_SOCKETS_WRAPPER_DNS_CACHE_TTL_MS    ( 60000U )
+#endif
+
+/**
+ * @brief Maximum length of a host name stored in the DNS cache. Longer names are not cached.
+ */
+#ifndef FREERTOS_SOCKETS_WRAPPER_DNS_CACHE_NAME_LENGTH
+    #define FREERTOS_SOCKETS_WRAPPER_DNS_CACHE_NAME_LENGTH    ( 64U )
+#endif
+
+/**
+ * @brief Stack size of the tasks started by TCP_Sockets_ConnectAsync().
+ */
+#ifndef FREERTOS_SOCKETS_WRAPPER_CONNECT_TASK_STACK_SIZE
+    #define FREERTOS_SOCKETS_WRAPPER_CONNECT_TASK_STACK_SIZE    ( configMINIMAL_STACK_SIZE * 4 )
+#endif
+
+/**
+ * @brief Priority of the tasks started by TCP_Sockets_ConnectAsync().
+ */
+#ifndef FREERTOS_SOCKETS_WRAPPER_CONNECT_TASK_PRIORITY
+    #define FREERTOS_SOCKETS_WRAPPER_CONNECT_TASK_PRIORITY    ( tskIDLE_PRIORITY + 1 )
+#endif
+
 /**
  * @brief negative error code indicating a network failure.
  */
 #define FREERTOS_SOCKETS_WRAPPER_NETWORK_ERROR    ( -1 )
 
 /**
- * @brief Establish a connection to server.
+ * @brief Poll interval of connection attempts in ticks, at least one tick.
+ */
+#define FREERTOS_SOCKETS_WRAPPER_CONNECT_POLL_TICKS                       \
+    ( ( pdMS_TO_TICKS( FREERTOS_SOCKETS_WRAPPER_CONNECT_POLL_MS ) > 0U ) ? \
+      pdMS_TO_TICKS( FREERTOS_SOCKETS_WRAPPER_CONNECT_POLL_MS ) : ( TickType_t ) 1U )
+
+/**
+ * @brief Convert ticks to milliseconds for logging.
+ */
+#define FREERTOS_SOCKETS_WRAPPER_TICKS_TO_MS( xTicks ) \
+    ( ( uint32_t ) ( ( ( uint64_t ) ( xTicks ) * 1000U ) / ( uint64_t ) configTICK_RATE_HZ ) )
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Addresses a host name resolved to, in the order connections are attempted.
+ */
+typedef struct ResolvedAddresses
+{
+    struct freertos_sockaddr addresses[ FREERTOS_SOCKETS_WRAPPER_MAX_ADDRESSES ];
+    BaseType_t addressCount;
+} ResolvedAddresses_t;
+
+/**
+ * @brief Parameters of a connection started by TCP_Sockets_ConnectAsync().
  *
- * @param[out] pTcpSocket The output parameter to return the created socket descriptor.
+ * The NULL terminated host name is stored directly after the structure.
+ */
+typedef struct ConnectRequest
+{
+    uint16_t port;
+    uint32_t receiveTimeoutMs;
+    uint32_t sendTimeoutMs;
+    TCP_Sockets_ConnectCallback_t connectCallback;
+    void * pCallbackContext;
+    TickType_t requestTime;
+} ConnectRequest_t;
+
+#if ( FREERTOS_SOCKETS_WRAPPER_DNS_CACHE_ENTRIES > 0 )
+
+/**
+ * @brief An entry of the DNS cache. The entry is unused when it holds no addresses.
+ */
+    typedef struct DnsCacheEntry
+    {
+        char hostName[ FREERTOS_SOCKETS_WRAPPER_DNS_CACHE_NAME_LENGTH + 1U ];
+        TickType_t resolveTime;
+        ResolvedAddresses_t resolved;
+    } DnsCacheEntry_t;
+
+/**
+ * @brief The DNS cache, accessed with the scheduler suspended.
+ */
+    static DnsCacheEntry_t dnsCache[ FREERTOS_SOCKETS_WRAPPER_DNS_CACHE_ENTRIES ];
+
+#endif /* if ( FREERTOS_SOCKETS_WRAPPER_DNS_CACHE_ENTRIES > 0 ) */
+
+#if ( FREERTOS_SOCKETS_WRAPPER_CLOSE_POLICY == FREERTOS_SOCKETS_WRAPPER_CLOSE_REAPER )
+
+/**
+ * @brief Queue of the sockets handed to the reaper task, NULL until the task runs.
+ */
+    static QueueHandle_t reaperQueue = NULL;
+
+/**
+ * @brief pdTRUE once a task started creating the reaper task.
+ */
+    static BaseType_t reaperStarted = pdFALSE;
+
+#endif /* if ( FREERTOS_SOCKETS_WRAPPER_CLOSE_POLICY == FREERTOS_SOCKETS_WRAPPER_CLOSE_REAPER ) */
+
+/*-----------------------------------------------------------*/
+
+#if ( FREERTOS_SOCKETS_WRAPPER_DNS_CACHE_ENTRIES > 0 )
+
+/**
+ * @brief Look up a host name in the DNS cache.
+ *
+ * @param[in] pHostName The host name to look up.
+ * @param[out] pResolved The cached addresses of the host.
+ *
+ * @return pdTRUE if an entry that has not expired was found, pdFALSE otherwise.
+ */
+    static BaseType_t prvDnsCacheLookup( const char * pHostName,
+                                         ResolvedAddresses_t * pResolved );
+
+/**
+ * @brief Store the addresses of a host name in the DNS cache, replacing the
+ * oldest entry if the cache is full.
+ *
+ * @param[in] pHostName The host name that was resolved.
+ * @param[in] pResolved The addresses the host name resolved to.
+ */
+    static void prvDnsCacheStore( const char * pHostName,
+                                  const ResolvedAddresses_t * pResolved );
+
+/**
+ * @brief Remove a host name from the DNS cache, so that the next connection
+ * resolves it again.
+ *
+ * @param[in] pHostName The host name to remove.
+ */
+    static void prvDnsCacheRemove( const char * pHostName );
+
+#endif /* if ( FREERTOS_SOCKETS_WRAPPER_DNS_CACHE_ENTRIES > 0 ) */
+
+/**
+ * @brief Resolve a host name to the addresses a connection will be attempted to.
+ *
+ * IPv6 and IPv4 addresses are interleaved, starting with IPv6.
+ *
+ * @param[in] pHostName The host name to resolve.
+ * @param[out] pResolved The addresses the host name resolved to.
+ * @param[out] pCacheHit Set to pdTRUE if the addresses were taken from the DNS cache.
+ */
+static void prvResolveHostName( const char * pHostName,
+                                ResolvedAddresses_t * pResolved,
+                                BaseType_t * pCacheHit );
+
+/**
+ * @brief Create a socket and start a connection to an address without waiting
+ * for it to be established.
+ *
+ * @param[in] pAddress The address to connect to.
+ *
+ * @return The socket on success, FREERTOS_INVALID_SOCKET on failure.
+ */
+static Socket_t prvStartConnectAttempt( const struct freertos_sockaddr * pAddress );
+
+/**
+ * @brief Check whether a connection attempt started by prvStartConnectAttempt() failed.
+ *
+ * @param[in] tcpSocket The socket of the connection attempt.
+ *
+ * @return pdTRUE if the attempt failed, pdFALSE if it is in progress or established.
+ */
+static BaseType_t prvConnectAttemptFailed( Socket_t tcpSocket );
+
+/**
+ * @brief Create a socket and connect it to an address, blocking until the
+ * connection is established or the receive block time of the socket expires.
+ *
+ * @param[in] pAddress The address to connect to.
+ *
+ * @return The socket on success, FREERTOS_INVALID_SOCKET on failure.
+ */
+static Socket_t prvBlockingConnect( const struct freertos_sockaddr * pAddress );
+
+/**
+ * @brief Race connection attempts to the resolved addresses, starting a new one
+ * every FREERTOS_SOCKETS_WRAPPER_CONNECT_ATTEMPT_DELAY_MS or as soon as all
+ * earlier ones failed.
+ *
+ * @param[in] pResolved The addresses to connect to.
+ * @param[out] pAddressesTried Number of addresses a connection was attempted to.
+ *
+ * @return The socket of the first established connection, FREERTOS_INVALID_SOCKET
+ * if none could be established.
+ */
+static Socket_t prvRaceConnectAttempts( const ResolvedAddresses_t * pResolved,
+                                        BaseType_t * pAddressesTried );
+
+/**
+ * @brief Resolve a host name, connect to it and configure the socket timeouts.
+ *
+ * @param[out] pTcpSocket The output parameter to return the connected socket.
  * @param[in] pHostName Server hostname to connect to.
- * @param[in] pServerInfo Server port to connect to.
+ * @param[in] port Server port to connect to.
  * @param[in] receiveTimeoutMs Timeout (in milliseconds) for transport receive.
  * @param[in] sendTimeoutMs Timeout (in milliseconds) for transport send.
- *
- * @note A timeout of 0 means infinite timeout.
+ * @param[in] requestTime Tick count at which the connection was requested.
+ * @param[out] pTimings Time spent in each phase of the connection.
  *
  * @return Non-zero value on error, 0 on success.
  */
-BaseType_t TCP_Sockets_Connect( Socket_t * pTcpSocket,
-                                const char * pHostName,
-                                uint16_t port,
-                                uint32_t receiveTimeoutMs,
-                                uint32_t sendTimeoutMs )
+static BaseType_t prvConnect( Socket_t * pTcpSocket,
+                              const char * pHostName,
+                              uint16_t port,
+                              uint32_t receiveTimeoutMs,
+                              uint32_t sendTimeoutMs,
+                              TickType_t requestTime,
+                              TCP_Sockets_ConnectTimings_t * pTimings );
+
+/**
+ * @brief Task started by TCP_Sockets_ConnectAsync() to perform a connection.
+ *
+ * @param[in] pvParameters The ConnectRequest_t of the connection, freed by the task.
+ */
+static void prvConnectTask( void * pvParameters );
+
+#if ( FREERTOS_SOCKETS_WRAPPER_CLOSE_POLICY != FREERTOS_SOCKETS_WRAPPER_CLOSE_DRAIN )
+
+/**
+ * @brief Wait at most FREERTOS_SOCKETS_WRAPPER_LINGER_MS for the peer to close a
+ * connection that was shut down, then close the socket.
+ *
+ * @param[in] tcpSocket The socket to close.
+ */
+    static void prvLingerAndClose( Socket_t tcpSocket );
+
+#endif
+
+#if ( FREERTOS_SOCKETS_WRAPPER_CLOSE_POLICY == FREERTOS_SOCKETS_WRAPPER_CLOSE_REAPER )
+
+/**
+ * @brief Hand a socket that was shut down to the reaper task, starting the task
+ * on first use.
+ *
+ * @param[in] tcpSocket The socket to close.
+ *
+ * @return pdPASS if the reaper task took ownership of the socket, pdFAIL otherwise.
+ */
+    static BaseType_t prvReaperEnqueue( Socket_t tcpSocket );
+
+/**
+ * @brief Task that closes the sockets handed to it once their peer closed the
+ * connection or FREERTOS_SOCKETS_WRAPPER_LINGER_MS elapsed.
+ *
+ * @param[in] pvParameters Unused.
+ */
+    static void prvReaperTask( void * pvParameters );
+
+#endif
+
+/*-----------------------------------------------------------*/
+
+#if ( FREERTOS_SOCKETS_WRAPPER_DNS_CACHE_ENTRIES > 0 )
+
+    static BaseType_t prvDnsCacheLookup( const char * pHostName,
+                                         ResolvedAddresses_t * pResolved )
+    {
+        BaseType_t found = pdFALSE;
+        BaseType_t index;
+        TickType_t now = xTaskGetTickCount();
+
+        vTaskSuspendAll();
+        {
+            for( index = 0; index < FREERTOS_SOCKETS_WRAPPER_DNS_CACHE_ENTRIES; index++ )
+            {
+                if( ( dnsCache[ index ].resolved.addressCount > 0 ) &&
+                    ( strcmp( dnsCache[ index ].hostName, pHostName ) == 0 ) )
+                {
+                    if( ( now - dnsCache[ index ].resolveTime ) < pdMS_TO_TICKS( FREERTOS_SOCKETS_WRAPPER_DNS_CACHE_TTL_MS ) )
+                    {
+                        *pResolved = dnsCache[ index ].resolved;
+                        found = pdTRUE;
+                    }
+                    else
+                    {
+                        /* Expired, free the entry. */
+                        dnsCache[ index ].resolved.addressCount = 0;
+                    }
+
+                    break;
+                }
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        return found;
+    }
+
+/*-----------------------------------------------------------*/
+
+    static void prvDnsCacheStore( const char * pHostName,
+                                  const ResolvedAddresses_t * pResolved )
+    {
+        BaseType_t index;
+        BaseType_t slot = 0;
+        TickType_t now = xTaskGetTickCount();
+        size_t hostNameLength = strlen( pHostName );
+
+        if( hostNameLength <= FREERTOS_SOCKETS_WRAPPER_DNS_CACHE_NAME_LENGTH )
+        {
+            vTaskSuspendAll();
+            {
+                /* Prefer the entry of the same host or an unused entry, otherwise
+                 * evict the oldest one. */
+                for( index = 0; index < FREERTOS_SOCKETS_WRAPPER_DNS_CACHE_ENTRIES; index++ )
+                {
+                    if( ( dnsCache[ index ].resolved.addressCount == 0 ) ||
+                        ( strcmp( dnsCache[ index ].hostName, pHostName ) == 0 ) )
+                    {
+                        slot = index;
+                        break;
+                    }
+
+                    if( ( now - dnsCache[ index ].resolveTime ) > ( now - dnsCache[ slot ].resolveTime ) )
+                    {
+                        slot = index;
+                    }
+                }
+
+                ( void ) memcpy( dnsCache[ slot ].hostName, pHostName, hostNameLength + 1U );
+                dnsCache[ slot ].resolveTime = now;
+                dnsCache[ slot ].resolved = *pResolved;
+            }
+            ( void ) xTaskResumeAll();
+        }
+    }
+
+/*-----------------------------------------------------------*/
+
+    static void prvDnsCacheRemove( const char * pHostName )
+    {
+        BaseType_t index;
+
+        vTaskSuspendAll();
+        {
+            for( index = 0; index < FREERTOS_SOCKETS_WRAPPER_DNS_CACHE_ENTRIES; index++ )
+            {
+                if( ( dnsCache[ index ].resolved.addressCount > 0 ) &&
+                    ( strcmp( dnsCache[ index ].hostName, pHostName ) == 0 ) )
+                {
+                    dnsCache[ index ].resolved.addressCount = 0;
+                    break;
+                }
+            }
+        }
+        ( void ) xTaskResumeAll();
+    }
+
+#endif /* if ( FREERTOS_SOCKETS_WRAPPER_DNS_CACHE_ENTRIES > 0 ) */
+
+/*-----------------------------------------------------------*/
+
+#if defined( ipconfigIPv4_BACKWARD_COMPATIBLE )
+
+/**
+ * @brief Append the addresses of one address family returned by FreeRTOS_getaddrinfo().
+ *
+ * @param[in] pHostName The host name to resolve.
+ * @param[in] family FREERTOS_AF_INET or FREERTOS_AF_INET6.
+ * @param[in,out] pResolved The list of addresses to append to.
+ */
+    static void prvGetAddresses( const char * pHostName,
+                                 BaseType_t family,
+                                 ResolvedAddresses_t * pResolved )
+    {
+        struct freertos_addrinfo hints;
+        struct freertos_addrinfo * pResults = NULL;
+        const struct freertos_addrinfo * pIter;
+
+        ( void ) memset( &hints, 0, sizeof( hints ) );
+        hints.ai_family = family;
+
+        if( FreeRTOS_getaddrinfo( pHostName, NULL, &hints, &pResults ) == 0 )
+        {
+            for( pIter = pResults;
+                 ( pIter != NULL ) && ( pResolved->addressCount < FREERTOS_SOCKETS_WRAPPER_MAX_ADDRESSES );
+                 pIter = pIter->ai_next )
+            {
+                if( ( pIter->ai_addr != NULL ) && ( pIter->ai_family == family ) )
+                {
+                    pResolved->addresses[ pResolved->addressCount ] = *( pIter->ai_addr );
+                    pResolved->addressCount++;
+                }
+            }
+        }
+
+        if( pResults != NULL )
+        {
+            FreeRTOS_freeaddrinfo( pResults );
+        }
+    }
+
+#endif /* if defined( ipconfigIPv4_BACKWARD_COMPATIBLE ) */
+
+/*-----------------------------------------------------------*/
+
+static void prvResolveHostName( const char * pHostName,
+                                ResolvedAddresses_t * pResolved,
+                                BaseType_t * pCacheHit )
+{
+    *pCacheHit = pdFALSE;
+    pResolved->addressCount = 0;
+
+    #if ( FREERTOS_SOCKETS_WRAPPER_DNS_CACHE_ENTRIES > 0 )
+        *pCacheHit = prvDnsCacheLookup( pHostName, pResolved );
+    #endif
+
+    if( *pCacheHit == pdFALSE )
+    {
+        #if defined( ipconfigIPv4_BACKWARD_COMPATIBLE )
+        {
+            ResolvedAddresses_t ipv4Addresses = { 0 };
+            ResolvedAddresses_t ipv6Addresses = { 0 };
+            BaseType_t ipv4Index = 0;
+            BaseType_t ipv6Index = 0;
+            BaseType_t preferIPv6 = pdTRUE;
+
+            #if defined( ipconfigUSE_IPv6 ) && ( ipconfigUSE_IPv6 != 0 )
+                prvGetAddresses( pHostName, FREERTOS_AF_INET6, &ipv6Addresses );
+            #endif
+
+            prvGetAddresses( pHostName, FREERTOS_AF_INET, &ipv4Addresses );
+
+            /* Interleave the address families, IPv6 first, so that a broken path
+             * of one family delays the connection by one attempt delay at most. */
+            while( pResolved->addressCount < FREERTOS_SOCKETS_WRAPPER_MAX_ADDRESSES )
+            {
+                if( ( preferIPv6 == pdTRUE ) && ( ipv6Index < ipv6Addresses.addressCount ) )
+                {
+                    pResolved->addresses[ pResolved->addressCount ] = ipv6Addresses.addresses[ ipv6Index ];
+                    ipv6Index++;
+                }
+                else if( ipv4Index < ipv4Addresses.addressCount )
+                {
+                    pResolved->addresses[ pResolved->addressCount ] = ipv4Addresses.addresses[ ipv4Index ];
+                    ipv4Index++;
+                }
+                else if( ipv6Index < ipv6Addresses.addressCount )
+                {
+                    pResolved->addresses[ pResolved->addressCount ] = ipv6Addresses.addresses[ ipv6Index ];
+                    ipv6Index++;
+                }
+                else
+                {
+                    break;
+                }
+
+                pResolved->addressCount++;
+                preferIPv6 = ( preferIPv6 == pdTRUE ) ? pdFALSE : pdTRUE;
+            }
+        }
+        #else /* if defined( ipconfigIPv4_BACKWARD_COMPATIBLE ) */
+        {
+            uint32_t ipAddress = ( uint32_t ) FreeRTOS_gethostbyname( pHostName );
+
+            if( ipAddress != 0U )
+            {
+                pResolved->addresses[ 0 ].sin_family = FREERTOS_AF_INET;
+                pResolved->addresses[ 0 ].sin_addr = ipAddress;
+                pResolved->addressCount = 1;
+            }
+        }
+        #endif /* if defined( ipconfigIPv4_BACKWARD_COMPATIBLE ) */
+
+        #if ( FREERTOS_SOCKETS_WRAPPER_DNS_CACHE_ENTRIES > 0 )
+            if( pResolved->addressCount > 0 )
+            {
+                prvDnsCacheStore( pHostName, pResolved );
+            }
+        #endif
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+static Socket_t prvStartConnectAttempt( const struct freertos_sockaddr * pAddress )
 {
     Socket_t tcpSocket = FREERTOS_INVALID_SOCKET;
-    BaseType_t socketStatus = 0;
-    struct freertos_sockaddr serverAddress = { 0 };
-    TickType_t transportTimeout = 0;
+    BaseType_t connectStatus = 0;
+    TickType_t noBlockTime = 0;
 
-    configASSERT( pTcpSocket != NULL );
-    configASSERT( pHostName != NULL );
+    tcpSocket = FreeRTOS_socket( ( BaseType_t ) pAddress->sin_family, FREERTOS_SOCK_STREAM, FREERTOS_IPPROTO_TCP );
 
-    /* Create a new TCP socket. */
-    tcpSocket = FreeRTOS_socket( FREERTOS_AF_INET, FREERTOS_SOCK_STREAM, FREERTOS_IPPROTO_TCP );
+    if( tcpSocket == FREERTOS_INVALID_SOCKET )
+    {
+        LogError( ( "Failed to create new socket." ) );
+    }
+    else
+    {
+        /* With a receive block time of zero FreeRTOS_connect() sends the SYN
+         * and returns without waiting for the connection to be established. */
+        ( void ) FreeRTOS_setsockopt( tcpSocket,
+                                      0,
+                                      FREERTOS_SO_RCVTIMEO,
+                                      &noBlockTime,
+                                      sizeof( TickType_t ) );
+
+        connectStatus = FreeRTOS_connect( tcpSocket, pAddress, sizeof( *pAddress ) );
+
+        if( ( connectStatus != 0 ) &&
+            ( connectStatus != -pdFREERTOS_ERRNO_EWOULDBLOCK ) &&
+            ( connectStatus != -pdFREERTOS_ERRNO_EINPROGRESS ) )
+        {
+            LogDebug( ( "Failed to start connection: FreeRTOS_Connect failed: ReturnCode=%d.",
+                        ( int ) connectStatus ) );
+            ( void ) FreeRTOS_closesocket( tcpSocket );
+            tcpSocket = FREERTOS_INVALID_SOCKET;
+        }
+    }
+
+    return tcpSocket;
+}
+
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvConnectAttemptFailed( Socket_t tcpSocket )
+{
+    BaseType_t connectionState = FreeRTOS_connstatus( tcpSocket );
+
+    /* A connection that is refused or times out goes back to a closed state. */
+    return ( ( connectionState == ( BaseType_t ) eCLOSED ) ||
+             ( connectionState == ( BaseType_t ) eCLOSE_WAIT ) ) ? pdTRUE : pdFALSE;
+}
+
+/*-----------------------------------------------------------*/
+
+static Socket_t prvBlockingConnect( const struct freertos_sockaddr * pAddress )
+{
+    Socket_t tcpSocket = FREERTOS_INVALID_SOCKET;
+    BaseType_t connectStatus = 0;
+
+    tcpSocket = FreeRTOS_socket( ( BaseType_t ) pAddress->sin_family, FREERTOS_SOCK_STREAM, FREERTOS_IPPROTO_TCP );
 
     if( tcpSocket == FREERTOS_INVALID_SOCKET )
     {
         LogError( ( "Failed to create new socket." ) );
-        socketStatus = FREERTOS_SOCKETS_WRAPPER_NETWORK_ERROR;
     }
     else
     {
-        LogDebug( ( "Created new TCP socket." ) );
+        connectStatus = FreeRTOS_connect( tcpSocket, pAddress, sizeof( *pAddress ) );
 
-        /* Connection parameters. */
-        serverAddress.sin_family = FREERTOS_AF_INET;
-        serverAddress.sin_port = FreeRTOS_htons( port );
-        serverAddress.sin_len = ( uint8_t ) sizeof( serverAddress );
+        if( connectStatus != 0 )
+        {
+            LogDebug( ( "FreeRTOS_Connect failed: ReturnCode=%d.",
+                        ( int ) connectStatus ) );
+            ( void ) FreeRTOS_closesocket( tcpSocket );
+            tcpSocket = FREERTOS_INVALID_SOCKET;
+        }
+    }
 
-        #if defined( ipconfigIPv4_BACKWARD_COMPATIBLE ) && ( ipconfigIPv4_BACKWARD_COMPATIBLE == 0 )
-            serverAddress.sin_address.ulIP_IPv4 = ( uint32_t ) FreeRTOS_gethostbyname( pHostName );
+    return tcpSocket;
+}
 
-            /* Check for errors from DNS lookup. */
-            if( serverAddress.sin_address.ulIP_IPv4 == 0U )
-        #else
-            serverAddress.sin_addr = ( uint32_t ) FreeRTOS_gethostbyname( pHostName );
+/*-----------------------------------------------------------*/
 
-            /* Check for errors from DNS lookup. */
-            if( serverAddress.sin_addr == 0U )
-        #endif /* defined( ipconfigIPv4_BACKWARD_COMPATIBLE ) && ( ipconfigIPv4_BACKWARD_COMPATIBLE == 0 ) */
+static Socket_t prvRaceConnectAttempts( const ResolvedAddresses_t * pResolved,
+                                        BaseType_t * pAddressesTried )
+{
+    Socket_t attempts[ FREERTOS_SOCKETS_WRAPPER_MAX_ADDRESSES ];
+    Socket_t connectedSocket = FREERTOS_INVALID_SOCKET;
+    BaseType_t nextAddress = 0;
+    BaseType_t pendingAttempts = 0;
+    BaseType_t index;
+    TickType_t startTime = xTaskGetTickCount();
+    TickType_t lastAttemptTime = startTime;
+    TickType_t now = startTime;
 
+    for( ;; )
+    {
+        /* Start the next attempt as soon as all earlier ones failed, or once
+         * the latest one had its head start. */
+        if( ( nextAddress < pResolved->addressCount ) &&
+            ( ( pendingAttempts == 0 ) ||
+              ( ( now - lastAttemptTime ) >= pdMS_TO_TICKS( FREERTOS_SOCKETS_WRAPPER_CONNECT_ATTEMPT_DELAY_MS ) ) ) )
         {
-            LogError( ( "Failed to connect to server: DNS resolution failed: Hostname=%s.",
-                        pHostName ) );
-            socketStatus = FREERTOS_SOCKETS_WRAPPER_NETWORK_ERROR;
+            attempts[ nextAddress ] = prvStartConnectAttempt( &( pResolved->addresses[ nextAddress ] ) );
+
+            if( attempts[ nextAddress ] != FREERTOS_INVALID_SOCKET )
+            {
+                pendingAttempts++;
+            }
+
+            nextAddress++;
+            lastAttemptTime = now;
         }
+
+        for( index = 0; ( index < nextAddress ) && ( connectedSocket == FREERTOS_INVALID_SOCKET ); index++ )
+        {
+            if( attempts[ index ] != FREERTOS_INVALID_SOCKET )
+            {
+                if( FreeRTOS_issocketconnected( attempts[ index ] ) == pdTRUE )
+                {
+                    connectedSocket = attempts[ index ];
+                    attempts[ index ] = FREERTOS_INVALID_SOCKET;
+                    pendingAttempts--;
+                }
+                else if( prvConnectAttemptFailed( attempts[ index ] ) == pdTRUE )
+                {
+                    ( void ) FreeRTOS_closesocket( attempts[ index ] );
+                    attempts[ index ] = FREERTOS_INVALID_SOCKET;
+                    pendingAttempts--;
+                }
+                else
+                {
+                    /* Still in progress. */
+                }
+            }
+        }
+
+        if( ( connectedSocket != FREERTOS_INVALID_SOCKET ) ||
+            ( ( pendingAttempts == 0 ) && ( nextAddress >= pResolved->addressCount ) ) ||
+            ( ( now - startTime ) >= ( TickType_t ) FREERTOS_SOCKETS_WRAPPER_CONNECT_TIMEOUT_TICKS ) )
+        {
+            break;
+        }
+
+        if( pendingAttempts > 0 )
+        {
+            vTaskDelay( FREERTOS_SOCKETS_WRAPPER_CONNECT_POLL_TICKS );
+        }
+
+        now = xTaskGetTickCount();
     }
 
-    if( socketStatus == 0 )
+    /* Abandon the attempts that lost the race. */
+    for( index = 0; index < nextAddress; index++ )
+    {
+        if( attempts[ index ] != FREERTOS_INVALID_SOCKET )
+        {
+            ( void ) FreeRTOS_closesocket( attempts[ index ] );
+        }
+    }
+
+    *pAddressesTried = nextAddress;
+
+    return connectedSocket;
+}
+
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvConnect( Socket_t * pTcpSocket,
+                              const char * pHostName,
+                              uint16_t port,
+                              uint32_t receiveTimeoutMs,
+                              uint32_t sendTimeoutMs,
+                              TickType_t requestTime,
+                              TCP_Sockets_ConnectTimings_t * pTimings )
+{
+    Socket_t tcpSocket = FREERTOS_INVALID_SOCKET;
+    BaseType_t socketStatus = 0;
+    ResolvedAddresses_t resolved;
+    BaseType_t index;
+    TickType_t phaseStartTime;
+    TickType_t transportTimeout = 0;
+
+    ( void ) memset( pTimings, 0, sizeof( TCP_Sockets_ConnectTimings_t ) );
+
+    phaseStartTime = xTaskGetTickCount();
+    prvResolveHostName( pHostName, &resolved, &( pTimings->dnsCacheHit ) );
+    pTimings->dnsTicks = xTaskGetTickCount() - phaseStartTime;
+
+    if( resolved.addressCount == 0 )
+    {
+        LogError( ( "Failed to connect to server: DNS resolution failed: Hostname=%s.",
+                    pHostName ) );
+        socketStatus = FREERTOS_SOCKETS_WRAPPER_NETWORK_ERROR;
+    }
+    else
     {
+        /* Connection parameters. */
+        for( index = 0; index < resolved.addressCount; index++ )
+        {
+            resolved.addresses[ index ].sin_port = FreeRTOS_htons( port );
+            resolved.addresses[ index ].sin_len = ( uint8_t ) sizeof( struct freertos_sockaddr );
+        }
+
         /* Establish connection. */
         LogDebug( ( "Creating TCP Connection to %s.", pHostName ) );
-        socketStatus = FreeRTOS_connect( tcpSocket, &serverAddress, sizeof( serverAddress ) );
+        phaseStartTime = xTaskGetTickCount();
 
-        if( socketStatus != 0 )
+        if( resolved.addressCount == 1 )
         {
-            LogError( ( "Failed to connect to server: FreeRTOS_Connect failed: ReturnCode=%d,"
-                        " Hostname=%s, Port=%u.",
-                        socketStatus,
+            /* Nothing to race, connect the way the socket is configured to. */
+            tcpSocket = prvBlockingConnect( &( resolved.addresses[ 0 ] ) );
+            pTimings->addressesTried = 1;
+        }
+        else
+        {
+            tcpSocket = prvRaceConnectAttempts( &resolved, &( pTimings->addressesTried ) );
+        }
+
+        pTimings->connectTicks = xTaskGetTickCount() - phaseStartTime;
+
+        if( tcpSocket == FREERTOS_INVALID_SOCKET )
+        {
+            LogError( ( "Failed to connect to server: No connection established:"
+                        " Hostname=%s, Port=%u, AddressesTried=%d.",
                         pHostName,
-                        port ) );
+                        port,
+                        ( int ) pTimings->addressesTried ) );
+            socketStatus = FREERTOS_SOCKETS_WRAPPER_NETWORK_ERROR;
+
+            #if ( FREERTOS_SOCKETS_WRAPPER_DNS_CACHE_ENTRIES > 0 )
+            {
+                /* The host may have moved, resolve it again next time. */
+                prvDnsCacheRemove( pHostName );
+            }
+            #endif
         }
     }
 
@@ -171,22 +921,296 @@ BaseType_t TCP_Sockets_Connect( Socket_t * pTcpSocket,
                                       FREERTOS_SO_SNDTIMEO,
                                       &transportTimeout,
                                       sizeof( TickType_t ) );
+
+        /* Set the socket. */
+        *pTcpSocket = tcpSocket;
     }
 
-    /* Clean up on failure. */
-    if( socketStatus != 0 )
+    pTimings->totalTicks = xTaskGetTickCount() - requestTime;
+
+    if( socketStatus == 0 )
     {
-        if( tcpSocket != FREERTOS_INVALID_SOCKET )
+        LogInfo( ( "Established TCP connection with %s in %u ms (DNS %u ms%s, connect %u ms).",
+                   pHostName,
+                   ( unsigned ) FREERTOS_SOCKETS_WRAPPER_TICKS_TO_MS( pTimings->totalTicks ),
+                   ( unsigned ) FREERTOS_SOCKETS_WRAPPER_TICKS_TO_MS( pTimings->dnsTicks ),
+                   ( pTimings->dnsCacheHit == pdTRUE ) ? ", cached" : "",
+                   ( unsigned ) FREERTOS_SOCKETS_WRAPPER_TICKS_TO_MS( pTimings->connectTicks ) ) );
+    }
+
+    return socketStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static void prvConnectTask( void * pvParameters )
+{
+    ConnectRequest_t * pRequest = ( ConnectRequest_t * ) pvParameters;
+    const char * pHostName = ( const char * ) &( pRequest[ 1 ] );
+    Socket_t tcpSocket = NULL;
+    TCP_Sockets_ConnectTimings_t timings;
+    BaseType_t socketStatus;
+
+    socketStatus = prvConnect( &tcpSocket,
+                               pHostName,
+                               pRequest->port,
+                               pRequest->receiveTimeoutMs,
+                               pRequest->sendTimeoutMs,
+                               pRequest->requestTime,
+                               &timings );
+
+    pRequest->connectCallback( socketStatus, tcpSocket, &timings, pRequest->pCallbackContext );
+
+    vPortFree( pRequest );
+    vTaskDelete( NULL );
+}
+
+/*-----------------------------------------------------------*/
+
+#if ( FREERTOS_SOCKETS_WRAPPER_CLOSE_POLICY != FREERTOS_SOCKETS_WRAPPER_CLOSE_DRAIN )
+
+    static void prvLingerAndClose( Socket_t tcpSocket )
+    {
+        TimeOut_t lingerTimeOut;
+        TickType_t remainingTicks = pdMS_TO_TICKS( FREERTOS_SOCKETS_WRAPPER_LINGER_MS );
+        uint8_t pDummyBuffer[ 2 ];
+
+        vTaskSetTimeOutState( &lingerTimeOut );
+
+        /* Wait for the socket to disconnect gracefully (indicated by FreeRTOS_recv()
+         * returning an error), bounding the total wait regardless of the receive
+         * timeout of the socket. */
+        do
         {
-            ( void ) FreeRTOS_closesocket( tcpSocket );
-            tcpSocket = FREERTOS_INVALID_SOCKET;
+            ( void ) FreeRTOS_setsockopt( tcpSocket,
+                                          0,
+                                          FREERTOS_SO_RCVTIMEO,
+                                          &remainingTicks,
+                                          sizeof( TickType_t ) );
+
+            if( FreeRTOS_recv( tcpSocket, pDummyBuffer, sizeof( pDummyBuffer ), 0 ) < 0 )
+            {
+                break;
+            }
+        } while( xTaskCheckForTimeOut( &lingerTimeOut, &remainingTicks ) == pdFALSE );
+
+        ( void ) FreeRTOS_closesocket( tcpSocket );
+    }
+
+#endif /* if ( FREERTOS_SOCKETS_WRAPPER_CLOSE_POLICY != FREERTOS_SOCKETS_WRAPPER_CLOSE_DRAIN ) */
+
+/*-----------------------------------------------------------*/
+
+#if ( FREERTOS_SOCKETS_WRAPPER_CLOSE_POLICY == FREERTOS_SOCKETS_WRAPPER_CLOSE_REAPER )
+
+    static BaseType_t prvReaperEnqueue( Socket_t tcpSocket )
+    {
+        BaseType_t startReaper = pdFALSE;
+        BaseType_t enqueueStatus = pdFAIL;
+        QueueHandle_t queue = NULL;
+
+        taskENTER_CRITICAL();
+        {
+            if( reaperStarted == pdFALSE )
+            {
+                reaperStarted = pdTRUE;
+                startReaper = pdTRUE;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( startReaper == pdTRUE )
+        {
+            queue = xQueueCreate( FREERTOS_SOCKETS_WRAPPER_REAPER_QUEUE_LENGTH, sizeof( Socket_t ) );
+
+            if( queue == NULL )
+            {
+                LogError( ( "Failed to create the socket reaper queue." ) );
+            }
+            else if( xTaskCreate( prvReaperTask,
+                                  "SockReaper",
+                                  FREERTOS_SOCKETS_WRAPPER_REAPER_TASK_STACK_SIZE,
+                                  queue,
+                                  FREERTOS_SOCKETS_WRAPPER_REAPER_TASK_PRIORITY,
+                                  NULL ) != pdPASS )
+            {
+                LogError( ( "Failed to create the socket reaper task." ) );
+                vQueueDelete( queue );
+            }
+            else
+            {
+                reaperQueue = queue;
+            }
+        }
+
+        /* Sockets closed while the reaper is being started, or after it failed
+         * to start, are closed by the calling task. */
+        if( reaperQueue != NULL )
+        {
+            enqueueStatus = xQueueSend( reaperQueue, &tcpSocket, 0 );
+        }
+
+        return enqueueStatus;
+    }
+
+/*-----------------------------------------------------------*/
+
+    static void prvReaperTask( void * pvParameters )
+    {
+        QueueHandle_t queue = ( QueueHandle_t ) pvParameters;
+        Socket_t lingeringSockets[ FREERTOS_SOCKETS_WRAPPER_REAPER_QUEUE_LENGTH ];
+        TickType_t shutdownTimes[ FREERTOS_SOCKETS_WRAPPER_REAPER_QUEUE_LENGTH ];
+        BaseType_t lingeringCount = 0;
+        BaseType_t index;
+        Socket_t tcpSocket;
+        TickType_t now;
+        TickType_t noBlockTime = 0;
+        uint8_t pDummyBuffer[ 2 ];
+
+        for( ;; )
+        {
+            /* Block indefinitely when there is nothing to close, otherwise wake
+             * up periodically to poll the lingering sockets. */
+            if( xQueueReceive( queue,
+                               &tcpSocket,
+                               ( lingeringCount == 0 ) ? portMAX_DELAY :
+                               pdMS_TO_TICKS( FREERTOS_SOCKETS_WRAPPER_REAPER_POLL_MS ) ) == pdPASS )
+            {
+                if( lingeringCount < FREERTOS_SOCKETS_WRAPPER_REAPER_QUEUE_LENGTH )
+                {
+                    ( void ) FreeRTOS_setsockopt( tcpSocket,
+                                                  0,
+                                                  FREERTOS_SO_RCVTIMEO,
+                                                  &noBlockTime,
+                                                  sizeof( TickType_t ) );
+                    lingeringSockets[ lingeringCount ] = tcpSocket;
+                    shutdownTimes[ lingeringCount ] = xTaskGetTickCount();
+                    lingeringCount++;
+                }
+                else
+                {
+                    /* Too many sockets are lingering, do not wait for this one. */
+                    ( void ) FreeRTOS_closesocket( tcpSocket );
+                }
+            }
+
+            now = xTaskGetTickCount();
+            index = 0;
+
+            while( index < lingeringCount )
+            {
+                if( ( FreeRTOS_recv( lingeringSockets[ index ], pDummyBuffer, sizeof( pDummyBuffer ), 0 ) < 0 ) ||
+                    ( ( now - shutdownTimes[ index ] ) >= pdMS_TO_TICKS( FREERTOS_SOCKETS_WRAPPER_LINGER_MS ) ) )
+                {
+                    ( void ) FreeRTOS_closesocket( lingeringSockets[ index ] );
+
+                    /* Move the last lingering socket into the freed slot. */
+                    lingeringCount--;
+                    lingeringSockets[ index ] = lingeringSockets[ lingeringCount ];
+                    shutdownTimes[ index ] = shutdownTimes[ lingeringCount ];
+                }
+                else
+                {
+                    index++;
+                }
+            }
         }
     }
+
+#endif /* if ( FREERTOS_SOCKETS_WRAPPER_CLOSE_POLICY == FREERTOS_SOCKETS_WRAPPER_CLOSE_REAPER ) */
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Establish a connection to server.
+ *
+ * @param[out] pTcpSocket The output parameter to return the created socket descriptor.
+ * @param[in] pHostName Server hostname to connect to.
+ * @param[in] pServerInfo Server port to connect to.
+ * @param[in] receiveTimeoutMs Timeout (in milliseconds) for transport receive.
+ * @param[in] sendTimeoutMs Timeout (in milliseconds) for transport send.
+ *
+ * @note A timeout of 0 means infinite timeout.
+ *
+ * @return Non-zero value on error, 0 on success.
+ */
+BaseType_t TCP_Sockets_Connect( Socket_t * pTcpSocket,
+                                const char * pHostName,
+                                uint16_t port,
+                                uint32_t receiveTimeoutMs,
+                                uint32_t sendTimeoutMs )
+{
+    TCP_Sockets_ConnectTimings_t timings;
+
+    configASSERT( pTcpSocket != NULL );
+    configASSERT( pHostName != NULL );
+
+    return prvConnect( pTcpSocket,
+                       pHostName,
+                       port,
+                       receiveTimeoutMs,
+                       sendTimeoutMs,
+                       xTaskGetTickCount(),
+                       &timings );
+}
+
+/**
+ * @brief Establish a connection to server without blocking the calling task.
+ *
+ * @param[in] pHostName Server hostname to connect to.
+ * @param[in] port Server port to connect to.
+ * @param[in] receiveTimeoutMs Timeout (in milliseconds) for transport receive.
+ * @param[in] sendTimeoutMs Timeout (in milliseconds) for transport send.
+ * @param[in] connectCallback Callback to invoke on completion.
+ * @param[in] pCallbackContext Context passed to @p connectCallback.
+ *
+ * @return 0 if the connection was started, non-zero value on error.
+ */
+BaseType_t TCP_Sockets_ConnectAsync( const char * pHostName,
+                                     uint16_t port,
+                                     uint32_t receiveTimeoutMs,
+                                     uint32_t sendTimeoutMs,
+                                     TCP_Sockets_ConnectCallback_t connectCallback,
+                                     void * pCallbackContext )
+{
+    BaseType_t socketStatus = FREERTOS_SOCKETS_WRAPPER_NETWORK_ERROR;
+    ConnectRequest_t * pRequest = NULL;
+    size_t hostNameLength = 0;
+
+    configASSERT( pHostName != NULL );
+    configASSERT( connectCallback != NULL );
+
+    hostNameLength = strlen( pHostName );
+    pRequest = ( ConnectRequest_t * ) pvPortMalloc( sizeof( ConnectRequest_t ) + hostNameLength + 1U );
+
+    if( pRequest == NULL )
+    {
+        LogError( ( "Failed to allocate connection request for %s.", pHostName ) );
+    }
     else
     {
-        /* Set the socket. */
-        *pTcpSocket = tcpSocket;
-        LogInfo( ( "Established TCP connection with %s.", pHostName ) );
+        pRequest->port = port;
+        pRequest->receiveTimeoutMs = receiveTimeoutMs;
+        pRequest->sendTimeoutMs = sendTimeoutMs;
+        pRequest->connectCallback = connectCallback;
+        pRequest->pCallbackContext = pCallbackContext;
+        pRequest->requestTime = xTaskGetTickCount();
+        ( void ) memcpy( &( pRequest[ 1 ] ), pHostName, hostNameLength + 1U );
+
+        if( xTaskCreate( prvConnectTask,
+                         "SockConnect",
+                         FREERTOS_SOCKETS_WRAPPER_CONNECT_TASK_STACK_SIZE,
+                         pRequest,
+                         FREERTOS_SOCKETS_WRAPPER_CONNECT_TASK_PRIORITY,
+                         NULL ) == pdPASS )
+        {
+            socketStatus = 0;
+        }
+        else
+        {
+            LogError( ( "Failed to create connection task for %s.", pHostName ) );
+            vPortFree( pRequest );
+        }
     }
 
     return socketStatus;
@@ -199,27 +1223,42 @@ BaseType_t TCP_Sockets_Connect( Socket_t * pTcpSocket,
  */
 void TCP_Sockets_Disconnect( Socket_t tcpSocket )
 {
-    BaseType_t waitForShutdownLoopCount = 0;
-    uint8_t pDummyBuffer[ 2 ];
-
     if( ( tcpSocket != NULL ) && ( tcpSocket != FREERTOS_INVALID_SOCKET ) )
     {
         /* Initiate graceful shutdown. */
         ( void ) FreeRTOS_shutdown( tcpSocket, FREERTOS_SHUT_RDWR );
 
-        /* Wait for the socket to disconnect gracefully (indicated by FreeRTOS_recv()
-         * returning a FREERTOS_EINVAL error) before closing the socket. */
-        while( FreeRTOS_recv( tcpSocket, pDummyBuffer, sizeof( pDummyBuffer ), 0 ) >= 0 )
+        #if ( FREERTOS_SOCKETS_WRAPPER_CLOSE_POLICY == FREERTOS_SOCKETS_WRAPPER_CLOSE_REAPER )
         {
-            /* We don't need to delay since FreeRTOS_recv should already have a timeout. */
-
-            if( ++waitForShutdownLoopCount >= FREERTOS_SOCKETS_WRAPPER_SHUTDOWN_LOOPS )
+            if( prvReaperEnqueue( tcpSocket ) != pdPASS )
             {
-                break;
+                prvLingerAndClose( tcpSocket );
             }
         }
+        #elif ( FREERTOS_SOCKETS_WRAPPER_CLOSE_POLICY == FREERTOS_SOCKETS_WRAPPER_CLOSE_LINGER )
+        {
+            prvLingerAndClose( tcpSocket );
+        }
+        #else
+        {
+            BaseType_t waitForShutdownLoopCount = 0;
+            uint8_t pDummyBuffer[ 2 ];
 
-        ( void ) FreeRTOS_closesocket( tcpSocket );
+            /* Wait for the socket to disconnect gracefully (indicated by FreeRTOS_recv()
+             * returning a FREERTOS_EINVAL error) before closing the socket. */
+            while( FreeRTOS_recv( tcpSocket, pDummyBuffer, sizeof( pDummyBuffer ), 0 ) >= 0 )
+            {
+                /* We don't need to delay since FreeRTOS_recv should already have a timeout. */
+
+                if( ++waitForShutdownLoopCount >= FREERTOS_SOCKETS_WRAPPER_SHUTDOWN_LOOPS )
+                {
+                    break;
+                }
+            }
+
+            ( void ) FreeRTOS_closesocket( tcpSocket );
+        }
+        #endif /* if ( FREERTOS_SOCKETS_WRAPPER_CLOSE_POLICY == FREERTOS_SOCKETS_WRAPPER_CLOSE_REAPER ) */
     }
 }
 
@@ -239,6 +239,55 @@ static TlsTransportStatus_t tlsHandshake( NetworkContext_t * pNetworkContext,
 static TlsTransportStatus_t initMbedtls( mbedtls_entropy_context * pEntropyContext,
                                          mbedtls_ctr_drbg_context * pCtrDrbgContext );
 
+/**
+ * @brief Write application data as a single TLS record and account for it in
+ * the record statistics of the connection.
+ *
+ * @param[in] pTlsTransportParams The transport parameters of the connection.
+ * @param[in] pBuffer Buffer containing the bytes to send.
+ * @param[in] bytesToSend Number of bytes to send from the buffer.
+ *
+ * @return Number of bytes (> 0) sent, which is at most one record payload;
+ * 0 if the write can be retried; negative value on error.
+ */
+static int32_t writeRecord( TlsTransportParams_t * pTlsTransportParams,
+                            const uint8_t * pBuffer,
+                            size_t bytesToSend );
+
+/**
+ * @brief Get the number of bytes batched into a record while corked.
+ *
+ * @param[in] pTlsTransportParams The transport parameters of the connection.
+ *
+ * @return The smaller of the cork buffer size and the maximum record payload.
+ */
+static size_t corkRecordSize( const TlsTransportParams_t * pTlsTransportParams );
+
+/**
+ * @brief Write the data batched while corked. Data that could not be written
+ * is kept at the start of the cork buffer.
+ *
+ * @param[in] pTlsTransportParams The transport parameters of the connection.
+ *
+ * @return Number of bytes written (>= 0); negative value on error.
+ */
+static int32_t flushCorkedData( TlsTransportParams_t * pTlsTransportParams );
+
+/**
+ * @brief Batch data into the cork buffer, writing a record whenever a full one
+ * is batched.
+ *
+ * @param[in] pTlsTransportParams The transport parameters of the connection.
+ * @param[in] pBuffer Buffer containing the bytes to send.
+ * @param[in] bytesToSend Number of bytes to send from the buffer.
+ *
+ * @return Number of bytes (> 0) accepted; 0 if the cork buffer is full and
+ * could not be written before the socket timed out; negative value on error.
+ */
+static int32_t corkData( TlsTransportParams_t * pTlsTransportParams,
+                         const uint8_t * pBuffer,
+                         size_t bytesToSend );
+
 /*-----------------------------------------------------------*/
 
 #ifdef MBEDTLS_DEBUG_C
@@ -687,6 +736,152 @@ static TlsTransportStatus_t initMbedtls( mbedtls_entropy_context * pEntropyConte
 }
 /*-----------------------------------------------------------*/
 
+static int32_t writeRecord( TlsTransportParams_t * pTlsTransportParams,
+                            const uint8_t * pBuffer,
+                            size_t bytesToSend )
+{
+    int32_t tlsStatus = 0;
+    int recordExpansion = 0;
+
+    tlsStatus = ( int32_t ) mbedtls_ssl_write( &( pTlsTransportParams->sslContext.context ),
+                                               pBuffer,
+                                               bytesToSend );
+
+    if( ( tlsStatus == MBEDTLS_ERR_SSL_TIMEOUT ) ||
+        ( tlsStatus == MBEDTLS_ERR_SSL_WANT_READ ) ||
+        ( tlsStatus == MBEDTLS_ERR_SSL_WANT_WRITE ) ||
+        ( tlsStatus == MBEDTLS_ERR_SSL_RECEIVED_NEW_SESSION_TICKET ) )
+    {
+        if( tlsStatus == MBEDTLS_ERR_SSL_RECEIVED_NEW_SESSION_TICKET )
+        {
+            LogDebug( ( "Received a MBEDTLS_ERR_SSL_RECEIVED_NEW_SESSION_TICKET return code from mbedtls_ssl_write." ) );
+        }
+
+        LogDebug( ( "Failed to send data. However, send can be retried on this error. "
+                    "mbedTLSError= %s : %s.",
+                    mbedtlsHighLevelCodeOrDefault( tlsStatus ),
+                    mbedtlsLowLevelCodeOrDefault( tlsStatus ) ) );
+
+        /* Mark these set of errors as a timeout. The libraries may retry send
+         * on these errors. */
+        tlsStatus = 0;
+    }
+    else if( tlsStatus < 0 )
+    {
+        LogError( ( "Failed to send data:  mbedTLSError= %s : %s.",
+                    mbedtlsHighLevelCodeOrDefault( tlsStatus ),
+                    mbedtlsLowLevelCodeOrDefault( tlsStatus ) ) );
+    }
+    else
+    {
+        /* mbedtls_ssl_write() writes at most one record per call. */
+        recordExpansion = mbedtls_ssl_get_record_expansion( &( pTlsTransportParams->sslContext.context ) );
+
+        pTlsTransportParams->recordsSent++;
+        pTlsTransportParams->wireBytesSent += ( uint32_t ) tlsStatus;
+
+        if( recordExpansion > 0 )
+        {
+            pTlsTransportParams->wireBytesSent += ( uint32_t ) recordExpansion;
+        }
+    }
+
+    return tlsStatus;
+}
+/*-----------------------------------------------------------*/
+
+static size_t corkRecordSize( const TlsTransportParams_t * pTlsTransportParams )
+{
+    size_t recordSize = pTlsTransportParams->corkBufferSize;
+    int maxPayload = 0;
+
+    /* Takes the negotiated maximum fragment length into account. */
+    maxPayload = mbedtls_ssl_get_max_out_record_payload( &( pTlsTransportParams->sslContext.context ) );
+
+    if( ( maxPayload > 0 ) && ( ( size_t ) maxPayload < recordSize ) )
+    {
+        recordSize = ( size_t ) maxPayload;
+    }
+
+    return recordSize;
+}
+/*-----------------------------------------------------------*/
+
+static int32_t flushCorkedData( TlsTransportParams_t * pTlsTransportParams )
+{
+    int32_t tlsStatus = 0;
+    size_t bytesWritten = 0U;
+
+    while( bytesWritten < pTlsTransportParams->corkedBytes )
+    {
+        tlsStatus = writeRecord( pTlsTransportParams,
+                                 &( pTlsTransportParams->pCorkBuffer[ bytesWritten ] ),
+                                 pTlsTransportParams->corkedBytes - bytesWritten );
+
+        if( tlsStatus <= 0 )
+        {
+            break;
+        }
+
+        bytesWritten += ( size_t ) tlsStatus;
+    }
+
+    if( bytesWritten > 0U )
+    {
+        ( void ) memmove( pTlsTransportParams->pCorkBuffer,
+                          &( pTlsTransportParams->pCorkBuffer[ bytesWritten ] ),
+                          pTlsTransportParams->corkedBytes - bytesWritten );
+        pTlsTransportParams->corkedBytes -= bytesWritten;
+    }
+
+    return ( tlsStatus < 0 ) ? tlsStatus : ( int32_t ) bytesWritten;
+}
+/*-----------------------------------------------------------*/
+
+static int32_t corkData( TlsTransportParams_t * pTlsTransportParams,
+                         const uint8_t * pBuffer,
+                         size_t bytesToSend )
+{
+    size_t recordSize = corkRecordSize( pTlsTransportParams );
+    size_t bytesAccepted = 0U;
+    size_t bytesToCopy = 0U;
+    int32_t flushStatus = 0;
+
+    /* A full record may be left over from a send that timed out. */
+    if( pTlsTransportParams->corkedBytes >= recordSize )
+    {
+        flushStatus = flushCorkedData( pTlsTransportParams );
+    }
+
+    while( ( bytesAccepted < bytesToSend ) &&
+           ( flushStatus >= 0 ) &&
+           ( pTlsTransportParams->corkedBytes < recordSize ) )
+    {
+        bytesToCopy = recordSize - pTlsTransportParams->corkedBytes;
+
+        if( bytesToCopy > ( bytesToSend - bytesAccepted ) )
+        {
+            bytesToCopy = bytesToSend - bytesAccepted;
+        }
+
+        ( void ) memcpy( &( pTlsTransportParams->pCorkBuffer[ pTlsTransportParams->corkedBytes ] ),
+                         &( pBuffer[ bytesAccepted ] ),
+                         bytesToCopy );
+        pTlsTransportParams->corkedBytes += bytesToCopy;
+        bytesAccepted += bytesToCopy;
+
+        if( pTlsTransportParams->corkedBytes >= recordSize )
+        {
+            /* A full record is batched, write it. */
+            flushStatus = flushCorkedData( pTlsTransportParams );
+        }
+    }
+
+    /* Errors are reported by the next call when data was accepted. */
+    return ( ( bytesAccepted == 0U ) && ( flushStatus < 0 ) ) ? flushStatus : ( int32_t ) bytesAccepted;
+}
+/*-----------------------------------------------------------*/
+
 TlsTransportStatus_t TLS_FreeRTOS_Connect( NetworkContext_t * pNetworkContext,
                                            const char * pHostName,
                                            uint16_t port,
@@ -711,14 +906,21 @@ TlsTransportStatus_t TLS_FreeRTOS_Connect( NetworkContext_t * pNetworkContext,
                     pNetworkCredentials ) );
         returnStatus = TLS_TRANSPORT_INVALID_PARAMETER;
     }
-    else if( ( pNetworkCredentials->pRootCa == NULL ) )
-    {
-        LogError( ( "pRootCa cannot be NULL." ) );
-        returnStatus = TLS_TRANSPORT_INVALID_PARAMETER;
-    }
     else
     {
-        /* Empty else for MISRA 15.7 compliance. */
+        /* Connections start uncorked. Set up before anything can fail so that
+         * TLS_FreeRTOS_Disconnect() does not see stale batched data. */
+        pNetworkContext->pParams->pCorkBuffer = NULL;
+        pNetworkContext->pParams->corkBufferSize = 0U;
+        pNetworkContext->pParams->corkedBytes = 0U;
+        pNetworkContext->pParams->recordsSent = 0U;
+        pNetworkContext->pParams->wireBytesSent = 0U;
+
+        if( ( pNetworkCredentials->pRootCa == NULL ) )
+        {
+            LogError( ( "pRootCa cannot be NULL." ) );
+            returnStatus = TLS_TRANSPORT_INVALID_PARAMETER;
+        }
     }
 
     /* Establish a TCP connection with the server. */
@@ -802,6 +1004,22 @@ void TLS_FreeRTOS_Disconnect( NetworkContext_t * pNetworkContext )
     if( ( pNetworkContext != NULL ) && ( pNetworkContext->pParams != NULL ) )
     {
         pTlsTransportParams = pNetworkContext->pParams;
+
+        /* Write the data batched while corked. */
+        if( pTlsTransportParams->corkedBytes > 0U )
+        {
+            ( void ) flushCorkedData( pTlsTransportParams );
+        }
+
+        pTlsTransportParams->pCorkBuffer = NULL;
+        pTlsTransportParams->corkBufferSize = 0U;
+        pTlsTransportParams->corkedBytes = 0U;
+
+        LogDebug( ( "(Network connection %p) Sent %u TLS records, %u bytes on the wire.",
+                    pNetworkContext,
+                    ( unsigned ) pTlsTransportParams->recordsSent,
+                    ( unsigned ) pTlsTransportParams->wireBytesSent ) );
+
         /* Attempting to terminate TLS connection. */
         tlsStatus = ( BaseType_t ) mbedtls_ssl_close_notify( &( pTlsTransportParams->sslContext.context ) );
 
@@ -931,41 +1149,135 @@ int32_t TLS_FreeRTOS_send( NetworkContext_t * pNetworkContext,
     {
         pTlsTransportParams = pNetworkContext->pParams;
 
-        tlsStatus = ( int32_t ) mbedtls_ssl_write( &( pTlsTransportParams->sslContext.context ),
-                                                   pBuffer,
-                                                   bytesToSend );
-
-        if( ( tlsStatus == MBEDTLS_ERR_SSL_TIMEOUT ) ||
-            ( tlsStatus == MBEDTLS_ERR_SSL_WANT_READ ) ||
-            ( tlsStatus == MBEDTLS_ERR_SSL_WANT_WRITE ) ||
-            ( tlsStatus == MBEDTLS_ERR_SSL_RECEIVED_NEW_SESSION_TICKET ) )
+        if( pTlsTransportParams->pCorkBuffer != NULL )
         {
-            if( tlsStatus == MBEDTLS_ERR_SSL_RECEIVED_NEW_SESSION_TICKET )
-            {
-                LogDebug( ( "Received a MBEDTLS_ERR_SSL_RECEIVED_NEW_SESSION_TICKET return code from mbedtls_ssl_write." ) );
-            }
+            tlsStatus = corkData( pTlsTransportParams, pBuffer, bytesToSend );
+        }
+        else
+        {
+            tlsStatus = writeRecord( pTlsTransportParams, pBuffer, bytesToSend );
+        }
+    }
 
-            LogDebug( ( "Failed to send data. However, send can be retried on this error. "
-                        "mbedTLSError= %s : %s.",
-                        mbedtlsHighLevelCodeOrDefault( tlsStatus ),
-                        mbedtlsLowLevelCodeOrDefault( tlsStatus ) ) );
+    return tlsStatus;
+}
+/*-----------------------------------------------------------*/
 
-            /* Mark these set of errors as a timeout. The libraries may retry send
-             * on these errors. */
-            tlsStatus = 0;
+TlsTransportStatus_t TLS_FreeRTOS_Cork( NetworkContext_t * pNetworkContext,
+                                        uint8_t * pCorkBuffer,
+                                        size_t corkBufferSize )
+{
+    TlsTransportStatus_t returnStatus = TLS_TRANSPORT_SUCCESS;
+
+    if( ( pNetworkContext == NULL ) || ( pNetworkContext->pParams == NULL ) )
+    {
+        LogError( ( "invalid input, pNetworkContext=%p", pNetworkContext ) );
+        returnStatus = TLS_TRANSPORT_INVALID_PARAMETER;
+    }
+    else if( ( pCorkBuffer == NULL ) || ( corkBufferSize == 0U ) )
+    {
+        LogError( ( "invalid input, pCorkBuffer=%p, corkBufferSize=%u",
+                    pCorkBuffer,
+                    ( unsigned ) corkBufferSize ) );
+        returnStatus = TLS_TRANSPORT_INVALID_PARAMETER;
+    }
+    else if( pNetworkContext->pParams->pCorkBuffer != NULL )
+    {
+        LogError( ( "(Network connection %p) Connection is already corked.",
+                    pNetworkContext ) );
+        returnStatus = TLS_TRANSPORT_INVALID_PARAMETER;
+    }
+    else
+    {
+        pNetworkContext->pParams->pCorkBuffer = pCorkBuffer;
+        pNetworkContext->pParams->corkBufferSize = corkBufferSize;
+        pNetworkContext->pParams->corkedBytes = 0U;
+    }
+
+    return returnStatus;
+}
+/*-----------------------------------------------------------*/
+
+int32_t TLS_FreeRTOS_Flush( NetworkContext_t * pNetworkContext )
+{
+    int32_t tlsStatus = 0;
+
+    if( ( pNetworkContext == NULL ) || ( pNetworkContext->pParams == NULL ) )
+    {
+        LogError( ( "invalid input, pNetworkContext=%p", pNetworkContext ) );
+        tlsStatus = -1;
+    }
+    else if( pNetworkContext->pParams->corkedBytes > 0U )
+    {
+        tlsStatus = flushCorkedData( pNetworkContext->pParams );
+    }
+    else
+    {
+        /* Nothing is batched. */
+    }
+
+    return tlsStatus;
+}
+/*-----------------------------------------------------------*/
+
+TlsTransportStatus_t TLS_FreeRTOS_Uncork( NetworkContext_t * pNetworkContext )
+{
+    TlsTransportStatus_t returnStatus = TLS_TRANSPORT_SUCCESS;
+    TlsTransportParams_t * pTlsTransportParams = NULL;
+
+    if( ( pNetworkContext == NULL ) || ( pNetworkContext->pParams == NULL ) )
+    {
+        LogError( ( "invalid input, pNetworkContext=%p", pNetworkContext ) );
+        returnStatus = TLS_TRANSPORT_INVALID_PARAMETER;
+    }
+    else
+    {
+        pTlsTransportParams = pNetworkContext->pParams;
+
+        if( pTlsTransportParams->corkedBytes > 0U )
+        {
+            ( void ) flushCorkedData( pTlsTransportParams );
         }
-        else if( tlsStatus < 0 )
+
+        if( pTlsTransportParams->corkedBytes == 0U )
         {
-            LogError( ( "Failed to send data:  mbedTLSError= %s : %s.",
-                        mbedtlsHighLevelCodeOrDefault( tlsStatus ),
-                        mbedtlsLowLevelCodeOrDefault( tlsStatus ) ) );
+            pTlsTransportParams->pCorkBuffer = NULL;
+            pTlsTransportParams->corkBufferSize = 0U;
         }
         else
         {
-            /* Empty else marker. */
+            LogError( ( "(Network connection %p) Failed to write %u batched bytes.",
+                        pNetworkContext,
+                        ( unsigned ) pTlsTransportParams->corkedBytes ) );
+            returnStatus = TLS_TRANSPORT_INTERNAL_ERROR;
         }
     }
 
-    return tlsStatus;
+    return returnStatus;
+}
+/*-----------------------------------------------------------*/
+
+TlsTransportStatus_t TLS_FreeRTOS_GetSendStats( const NetworkContext_t * pNetworkContext,
+                                                uint32_t * pRecordsSent,
+                                                uint32_t * pWireBytesSent )
+{
+    TlsTransportStatus_t returnStatus = TLS_TRANSPORT_SUCCESS;
+
+    if( ( pNetworkContext == NULL ) || ( pNetworkContext->pParams == NULL ) ||
+        ( pRecordsSent == NULL ) || ( pWireBytesSent == NULL ) )
+    {
+        LogError( ( "invalid input, pNetworkContext=%p, pRecordsSent=%p, pWireBytesSent=%p",
+                    pNetworkContext,
+                    pRecordsSent,
+                    pWireBytesSent ) );
+        returnStatus = TLS_TRANSPORT_INVALID_PARAMETER;
+    }
+    else
+    {
+        *pRecordsSent = pNetworkContext->pParams->recordsSent;
+        *pWireBytesSent = pNetworkContext->pParams->wireBytesSent;
+    }
+
+    return returnStatus;
 }
 /*-----------------------------------------------------------*/
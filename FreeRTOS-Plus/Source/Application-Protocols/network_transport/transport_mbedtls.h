@@ -116,6 +116,11 @@ typedef struct TlsTransportParams
 {
     Socket_t tcpSocket;
     SSLContext_t sslContext;
+    uint8_t * pCorkBuffer;  /**< @brief Buffer of the data batched while corked, NULL when not corked. */
+    size_t corkBufferSize;  /**< @brief Size of #TlsTransportParams_t.pCorkBuffer. */
+    size_t corkedBytes;     /**< @brief Number of bytes batched in #TlsTransportParams_t.pCorkBuffer. */
+    uint32_t recordsSent;   /**< @brief Number of application data records sent on the connection. */
+    uint32_t wireBytesSent; /**< @brief Bytes of application data sent, including the record overhead. */
 } TlsTransportParams_t;
 
 /**
@@ -224,6 +229,69 @@ int32_t TLS_FreeRTOS_send( NetworkContext_t * pNetworkContext,
                            const void * pBuffer,
                            size_t bytesToSend );
 
+/**
+ * @brief Start batching the data sent with TLS_FreeRTOS_send() into full-size
+ * TLS records.
+ *
+ * While corked, TLS_FreeRTOS_send() copies data into @p pCorkBuffer and only
+ * writes a record once the buffer holds the maximum record payload negotiated
+ * for the connection (see the maximum fragment length set at connect time).
+ * Batched data is only written by TLS_FreeRTOS_Flush(), TLS_FreeRTOS_Uncork()
+ * and TLS_FreeRTOS_Disconnect(), so the caller must flush a request before
+ * waiting for its response. TLS_FreeRTOS_recv() never writes, which keeps it
+ * safe to receive from one task while another sends.
+ *
+ * @param[in] pNetworkContext The network context of an established connection.
+ * @param[in] pCorkBuffer Buffer for the batched data. It must remain valid until
+ * TLS_FreeRTOS_Uncork() succeeds or the connection is disconnected.
+ * @param[in] corkBufferSize Size of @p pCorkBuffer. Only up to one maximum
+ * record payload of it is used.
+ *
+ * @return #TLS_TRANSPORT_SUCCESS or #TLS_TRANSPORT_INVALID_PARAMETER.
+ */
+TlsTransportStatus_t TLS_FreeRTOS_Cork( NetworkContext_t * pNetworkContext,
+                                        uint8_t * pCorkBuffer,
+                                        size_t corkBufferSize );
+
+/**
+ * @brief Write the data batched while corked as TLS records.
+ *
+ * @param[in] pNetworkContext The network context.
+ *
+ * @return Number of batched bytes written (>= 0), which is less than the
+ * number of batched bytes if the socket timed out; negative value on error.
+ * Data that was not written stays batched.
+ */
+int32_t TLS_FreeRTOS_Flush( NetworkContext_t * pNetworkContext );
+
+/**
+ * @brief Write the data batched while corked and stop batching.
+ *
+ * @param[in] pNetworkContext The network context.
+ *
+ * @return #TLS_TRANSPORT_SUCCESS if all batched data was written, otherwise
+ * #TLS_TRANSPORT_INVALID_PARAMETER or #TLS_TRANSPORT_INTERNAL_ERROR, in which
+ * case the connection remains corked.
+ */
+TlsTransportStatus_t TLS_FreeRTOS_Uncork( NetworkContext_t * pNetworkContext );
+
+/**
+ * @brief Get the number of application data records sent on a connection and
+ * the bytes they took on the wire, including the record expansion.
+ *
+ * Comparing the counters before and after a send shows how many records it
+ * took, with or without corking.
+ *
+ * @param[in] pNetworkContext The network context.
+ * @param[out] pRecordsSent Number of records sent since the connection was made.
+ * @param[out] pWireBytesSent Number of bytes those records took on the wire.
+ *
+ * @return #TLS_TRANSPORT_SUCCESS or #TLS_TRANSPORT_INVALID_PARAMETER.
+ */
+TlsTransportStatus_t TLS_FreeRTOS_GetSendStats( const NetworkContext_t * pNetworkContext,
+                                                uint32_t * pRecordsSent,
+                                                uint32_t * pWireBytesSent );
+
 
 #ifdef MBEDTLS_DEBUG_C
 
@@ -0,0 +1,63 @@
+/*
+ * FreeRTOS V202212.00
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Minimal stand-in for the FreeRTOS kernel headers, enough to build
+ * tcp_sockets_wrapper.c on the host.  See fake_network.c.
+ */
+
+#ifndef FREERTOS_H
+#define FREERTOS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef long            BaseType_t;
+typedef unsigned long   UBaseType_t;
+typedef uint32_t        TickType_t;
+typedef void *          TaskHandle_t;
+typedef void *          QueueHandle_t;
+
+#define pdFALSE                     ( ( BaseType_t ) 0 )
+#define pdTRUE                      ( ( BaseType_t ) 1 )
+#define pdFAIL                      ( pdFALSE )
+#define pdPASS                      ( pdTRUE )
+#define portMAX_DELAY               ( ( TickType_t ) 0xffffffffUL )
+
+#define configTICK_RATE_HZ          ( 1000 )
+#define configMINIMAL_STACK_SIZE    ( 256 )
+#define tskIDLE_PRIORITY            ( ( UBaseType_t ) 0U )
+
+#define pdMS_TO_TICKS( xTimeInMs )    ( ( TickType_t ) ( ( ( uint64_t ) ( xTimeInMs ) * ( uint64_t ) configTICK_RATE_HZ ) / ( uint64_t ) 1000U ) )
+
+void vFakeAssertCalled( const char * pcFile,
+                        unsigned long ulLine );
+#define configASSERT( x )    do { if( ( x ) == 0 ) { vFakeAssertCalled( __FILE__, __LINE__ ); } } while( 0 )
+
+void * pvPortMalloc( size_t xSize );
+void vPortFree( void * pv );
+
+#endif /* FREERTOS_H */
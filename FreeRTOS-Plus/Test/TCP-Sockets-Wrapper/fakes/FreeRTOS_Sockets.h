@@ -0,0 +1,2 @@
+/* See fake_freertos_plus_tcp.h. */
+#include "fake_freertos_plus_tcp.h"
@@ -0,0 +1,148 @@
+/*
+ * FreeRTOS V202212.00
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Minimal stand-in for the FreeRTOS+TCP headers.  FreeRTOS_IP.h,
+ * FreeRTOS_Sockets.h, FreeRTOS_DNS.h and FreeRTOS_TCP_IP.h all include this
+ * file.  The declarations match FreeRTOS+TCP V4, which provides
+ * FreeRTOS_getaddrinfo() for both address families.
+ */
+
+#ifndef FAKE_FREERTOS_PLUS_TCP_H
+#define FAKE_FREERTOS_PLUS_TCP_H
+
+#include "FreeRTOS.h"
+
+#define ipconfigIPv4_BACKWARD_COMPATIBLE           0
+#define ipconfigUSE_IPv6                           1
+#define ipconfigSOCK_DEFAULT_RECEIVE_BLOCK_TIME    pdMS_TO_TICKS( 5000U )
+
+#define FREERTOS_AF_INET                           ( 2 )
+#define FREERTOS_AF_INET6                          ( 10 )
+#define FREERTOS_SOCK_STREAM                       ( 1 )
+#define FREERTOS_IPPROTO_TCP                       ( 6 )
+#define FREERTOS_SO_RCVTIMEO                       ( 0 )
+#define FREERTOS_SO_SNDTIMEO                       ( 1 )
+#define FREERTOS_SHUT_RDWR                         ( 2 )
+
+#define pdFREERTOS_ERRNO_ENOENT                    2
+#define pdFREERTOS_ERRNO_EINTR                     4
+#define pdFREERTOS_ERRNO_EWOULDBLOCK               11
+#define pdFREERTOS_ERRNO_ENOMEM                    12
+#define pdFREERTOS_ERRNO_EINVAL                    22
+#define pdFREERTOS_ERRNO_ENOSPC                    28
+#define pdFREERTOS_ERRNO_EINPROGRESS               115
+#define pdFREERTOS_ERRNO_ETIMEDOUT                 116
+#define pdFREERTOS_ERRNO_ENOTCONN                  128
+
+typedef uint32_t socklen_t;
+
+typedef struct xIPv6_Address
+{
+    uint8_t ucBytes[ 16 ];
+} IPv6_Address_t;
+
+typedef union IP_Address
+{
+    uint32_t ulIP_IPv4;
+    IPv6_Address_t xIP_IPv6;
+} IP_Address_t;
+
+struct freertos_sockaddr
+{
+    uint8_t sin_len;
+    uint8_t sin_family;
+    uint16_t sin_port;
+    uint32_t sin_flowinfo;
+    IP_Address_t sin_address;
+};
+
+struct freertos_addrinfo
+{
+    BaseType_t ai_flags;
+    BaseType_t ai_family;
+    BaseType_t ai_socktype;
+    BaseType_t ai_protocol;
+    socklen_t ai_addrlen;
+    struct freertos_sockaddr * ai_addr;
+    char * ai_canonname;
+    struct freertos_addrinfo * ai_next;
+};
+
+struct xSOCKET;
+typedef struct xSOCKET * Socket_t;
+#define SOCKET_T_TYPEDEFED
+
+#define FREERTOS_INVALID_SOCKET    ( ( Socket_t ) ~0U )
+
+typedef enum eTCP_STATE
+{
+    eCLOSED = 0,
+    eTCP_LISTEN,
+    eCONNECT_SYN,
+    eSYN_FIRST,
+    eSYN_RECEIVED,
+    eESTABLISHED,
+    eFIN_WAIT_1,
+    eFIN_WAIT_2,
+    eCLOSE_WAIT,
+    eCLOSING,
+    eLAST_ACK,
+    eTIME_WAIT
+} eIPTCPState_t;
+
+uint16_t FreeRTOS_htons( uint16_t usIn );
+Socket_t FreeRTOS_socket( BaseType_t xDomain,
+                          BaseType_t xType,
+                          BaseType_t xProtocol );
+BaseType_t FreeRTOS_setsockopt( Socket_t xSocket,
+                                int32_t lLevel,
+                                int32_t lOptionName,
+                                const void * pvOptionValue,
+                                size_t uxOptionLength );
+BaseType_t FreeRTOS_connect( Socket_t xClientSocket,
+                             const struct freertos_sockaddr * pxAddress,
+                             socklen_t xAddressLength );
+BaseType_t FreeRTOS_shutdown( Socket_t xSocket,
+                              BaseType_t xHow );
+BaseType_t FreeRTOS_closesocket( Socket_t xSocket );
+BaseType_t FreeRTOS_recv( Socket_t xSocket,
+                          void * pvBuffer,
+                          size_t uxBufferLength,
+                          BaseType_t xFlags );
+BaseType_t FreeRTOS_send( Socket_t xSocket,
+                          const void * pvBuffer,
+                          size_t uxDataLength,
+                          BaseType_t xFlags );
+BaseType_t FreeRTOS_issocketconnected( Socket_t xSocket );
+BaseType_t FreeRTOS_connstatus( Socket_t xSocket );
+BaseType_t FreeRTOS_getaddrinfo( const char * pcName,
+                                 const char * pcService,
+                                 const struct freertos_addrinfo * pxHints,
+                                 struct freertos_addrinfo ** ppxResult );
+void FreeRTOS_freeaddrinfo( struct freertos_addrinfo * pxInfo );
+
+#endif /* FAKE_FREERTOS_PLUS_TCP_H */
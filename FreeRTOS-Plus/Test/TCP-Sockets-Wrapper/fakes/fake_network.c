@@ -0,0 +1,787 @@
+/*
+ * FreeRTOS V202212.00
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Fake FreeRTOS kernel and FreeRTOS+TCP stack for the host test of the
+ * sockets wrapper, see fake_network.h.
+ */
+
+/* Standard includes. */
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Fake FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_Sockets.h"
+#include "fake_network.h"
+
+#define fakeMAX_HOST_ADDRESSES    16
+#define fakeMAX_SOCKETS           32
+#define fakeMAX_TASKS             8
+#define fakeMAX_QUEUES            4
+#define fakeMAX_QUEUE_ITEMS       16
+#define fakeMAX_ITEM_SIZE         16
+
+/* Reasons for a fake task to return to vFakeRunTasks(). */
+#define fakeTASK_DELETED          1
+#define fakeTASK_BLOCKED          2
+
+typedef struct
+{
+    char cHost[ 32 ];
+    BaseType_t xFamily;
+    uint32_t ulAddress;
+    FakeOutcome_t eOutcome;
+    TickType_t xLatency;
+} FakeHostAddress_t;
+
+struct xSOCKET
+{
+    BaseType_t xInUse;
+    BaseType_t xFamily;
+    uint32_t ulAddress;
+    FakeOutcome_t eOutcome;
+    TickType_t xLatency;
+    TickType_t xConnectTime;
+    TickType_t xReceiveTimeout;
+    TickType_t xPeerCloseTime;
+    BaseType_t xConnectStarted;
+    BaseType_t xConnectedBlocking;
+    BaseType_t xShutdown;
+    BaseType_t xClosed;
+    TickType_t xCloseTime;
+};
+
+typedef struct
+{
+    TaskFunction_t pxTaskCode;
+    void * pvParameters;
+    BaseType_t xInUse;
+} FakeTask_t;
+
+typedef struct
+{
+    BaseType_t xInUse;
+    UBaseType_t uxLength;
+    UBaseType_t uxItemSize;
+    UBaseType_t uxHead;
+    UBaseType_t uxCount;
+    uint8_t ucItems[ fakeMAX_QUEUE_ITEMS ][ fakeMAX_ITEM_SIZE ];
+} FakeQueue_t;
+
+static TickType_t xTickCount = 0;
+static FakeHostAddress_t xHostAddresses[ fakeMAX_HOST_ADDRESSES ];
+static size_t uxHostAddressCount = 0;
+static struct xSOCKET xSockets[ fakeMAX_SOCKETS ];
+static FakeTask_t xTasks[ fakeMAX_TASKS ];
+static FakeQueue_t xQueues[ fakeMAX_QUEUES ];
+static TickType_t xPeerCloseDelay = 0;
+static size_t uxLookupCount = 0;
+static long lLiveAllocations = 0;
+
+/* Where vTaskDelete() and a blocking xQueueReceive() return to, valid while
+ * vFakeRunTasks() runs a task. */
+static jmp_buf xTaskReturn;
+static BaseType_t xInTask = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+void vFakeAssertCalled( const char * pcFile,
+                        unsigned long ulLine )
+{
+    printf( "configASSERT() failed at %s:%lu\n", pcFile, ulLine );
+    abort();
+}
+
+/*-----------------------------------------------------------*/
+
+void vFakeReset( void )
+{
+    xTickCount = 0;
+    uxHostAddressCount = 0;
+    xPeerCloseDelay = 0;
+    uxLookupCount = 0;
+    ( void ) memset( xSockets, 0, sizeof( xSockets ) );
+
+    /* Tasks and queues are kept, the wrapper starts its reaper task only once. */
+}
+
+/*-----------------------------------------------------------*/
+
+void vFakeAddHostAddress( const char * pcHost,
+                          BaseType_t xFamily,
+                          uint32_t ulAddress,
+                          FakeOutcome_t eOutcome,
+                          TickType_t xLatency )
+{
+    FakeHostAddress_t * pxEntry;
+
+    configASSERT( uxHostAddressCount < fakeMAX_HOST_ADDRESSES );
+    pxEntry = &( xHostAddresses[ uxHostAddressCount ] );
+    ( void ) snprintf( pxEntry->cHost, sizeof( pxEntry->cHost ), "%s", pcHost );
+    pxEntry->xFamily = xFamily;
+    pxEntry->ulAddress = ulAddress;
+    pxEntry->eOutcome = eOutcome;
+    pxEntry->xLatency = xLatency;
+    uxHostAddressCount++;
+}
+
+/*-----------------------------------------------------------*/
+
+void vFakeSetPeerCloseDelay( TickType_t xDelay )
+{
+    xPeerCloseDelay = xDelay;
+}
+
+/*-----------------------------------------------------------*/
+
+void vFakeRunTasks( void )
+{
+    BaseType_t xProgress;
+    volatile size_t x;
+    int iReason;
+
+    /* Tasks may create further tasks, so keep going until a pass over all of
+     * them leaves each one blocked or deleted. */
+    do
+    {
+        xProgress = pdFALSE;
+
+        for( x = 0; x < fakeMAX_TASKS; x++ )
+        {
+            if( xTasks[ x ].xInUse == pdTRUE )
+            {
+                xInTask = pdTRUE;
+                iReason = setjmp( xTaskReturn );
+
+                if( iReason == 0 )
+                {
+                    xTasks[ x ].pxTaskCode( xTasks[ x ].pvParameters );
+
+                    /* A FreeRTOS task must not return. */
+                    configASSERT( pdFALSE );
+                }
+
+                xInTask = pdFALSE;
+
+                if( iReason == fakeTASK_DELETED )
+                {
+                    xTasks[ x ].xInUse = pdFALSE;
+                    xProgress = pdTRUE;
+                }
+            }
+        }
+    } while( xProgress == pdTRUE );
+}
+
+/*-----------------------------------------------------------*/
+
+size_t uxFakeTaskCount( void )
+{
+    size_t x, uxCount = 0;
+
+    for( x = 0; x < fakeMAX_TASKS; x++ )
+    {
+        if( xTasks[ x ].xInUse == pdTRUE )
+        {
+            uxCount++;
+        }
+    }
+
+    return uxCount;
+}
+
+/*-----------------------------------------------------------*/
+
+size_t uxFakeLookupCount( void )
+{
+    return uxLookupCount;
+}
+
+/*-----------------------------------------------------------*/
+
+size_t uxFakeOpenSocketCount( void )
+{
+    size_t x, uxCount = 0;
+
+    for( x = 0; x < fakeMAX_SOCKETS; x++ )
+    {
+        if( ( xSockets[ x ].xInUse == pdTRUE ) && ( xSockets[ x ].xClosed == pdFALSE ) )
+        {
+            uxCount++;
+        }
+    }
+
+    return uxCount;
+}
+
+/*-----------------------------------------------------------*/
+
+size_t uxFakeLiveAllocationCount( void )
+{
+    return ( size_t ) lLiveAllocations;
+}
+
+/*-----------------------------------------------------------*/
+
+uint32_t ulFakeSocketAddress( Socket_t xSocket )
+{
+    return xSocket->ulAddress;
+}
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xFakeSocketConnectedBlocking( Socket_t xSocket )
+{
+    return xSocket->xConnectedBlocking;
+}
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xFakeSocketClosed( Socket_t xSocket )
+{
+    return xSocket->xClosed;
+}
+
+/*-----------------------------------------------------------*/
+
+TickType_t xFakeSocketCloseTime( Socket_t xSocket )
+{
+    return xSocket->xCloseTime;
+}
+
+/*-----------------------------------------------------------*/
+/* Kernel. */
+/*-----------------------------------------------------------*/
+
+void * pvPortMalloc( size_t xSize )
+{
+    void * pv = malloc( xSize );
+
+    if( pv != NULL )
+    {
+        lLiveAllocations++;
+    }
+
+    return pv;
+}
+
+/*-----------------------------------------------------------*/
+
+void vPortFree( void * pv )
+{
+    if( pv != NULL )
+    {
+        lLiveAllocations--;
+        free( pv );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+TickType_t xTaskGetTickCount( void )
+{
+    return xTickCount;
+}
+
+/*-----------------------------------------------------------*/
+
+void vTaskDelay( TickType_t xTicksToDelay )
+{
+    xTickCount += xTicksToDelay;
+}
+
+/*-----------------------------------------------------------*/
+
+void vTaskSuspendAll( void )
+{
+}
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskResumeAll( void )
+{
+    return pdFALSE;
+}
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskCreate( TaskFunction_t pxTaskCode,
+                        const char * const pcName,
+                        const uint32_t usStackDepth,
+                        void * const pvParameters,
+                        UBaseType_t uxPriority,
+                        TaskHandle_t * const pxCreatedTask )
+{
+    size_t x;
+    BaseType_t xReturn = pdFAIL;
+
+    ( void ) pcName;
+    ( void ) usStackDepth;
+    ( void ) uxPriority;
+
+    for( x = 0; x < fakeMAX_TASKS; x++ )
+    {
+        if( xTasks[ x ].xInUse == pdFALSE )
+        {
+            xTasks[ x ].pxTaskCode = pxTaskCode;
+            xTasks[ x ].pvParameters = pvParameters;
+            xTasks[ x ].xInUse = pdTRUE;
+
+            if( pxCreatedTask != NULL )
+            {
+                *pxCreatedTask = &( xTasks[ x ] );
+            }
+
+            xReturn = pdPASS;
+            break;
+        }
+    }
+
+    return xReturn;
+}
+
+/*-----------------------------------------------------------*/
+
+void vTaskDelete( TaskHandle_t xTaskToDelete )
+{
+    /* Only a task deleting itself is supported. */
+    configASSERT( xTaskToDelete == NULL );
+    configASSERT( xInTask == pdTRUE );
+    longjmp( xTaskReturn, fakeTASK_DELETED );
+}
+
+/*-----------------------------------------------------------*/
+
+void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
+{
+    pxTimeOut->xOverflowCount = 0;
+    pxTimeOut->xTimeOnEntering = xTickCount;
+}
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
+                                 TickType_t * const pxTicksToWait )
+{
+    BaseType_t xReturn = pdFALSE;
+    TickType_t xElapsed = xTickCount - pxTimeOut->xTimeOnEntering;
+
+    if( *pxTicksToWait == portMAX_DELAY )
+    {
+        xReturn = pdFALSE;
+    }
+    else if( xElapsed < *pxTicksToWait )
+    {
+        *pxTicksToWait -= xElapsed;
+        vTaskSetTimeOutState( pxTimeOut );
+    }
+    else
+    {
+        *pxTicksToWait = 0;
+        xReturn = pdTRUE;
+    }
+
+    return xReturn;
+}
+
+/*-----------------------------------------------------------*/
+
+QueueHandle_t xQueueCreate( UBaseType_t uxQueueLength,
+                            UBaseType_t uxItemSize )
+{
+    size_t x;
+    QueueHandle_t xReturn = NULL;
+
+    configASSERT( uxQueueLength <= fakeMAX_QUEUE_ITEMS );
+    configASSERT( uxItemSize <= fakeMAX_ITEM_SIZE );
+
+    for( x = 0; x < fakeMAX_QUEUES; x++ )
+    {
+        if( xQueues[ x ].xInUse == pdFALSE )
+        {
+            ( void ) memset( &( xQueues[ x ] ), 0, sizeof( xQueues[ x ] ) );
+            xQueues[ x ].xInUse = pdTRUE;
+            xQueues[ x ].uxLength = uxQueueLength;
+            xQueues[ x ].uxItemSize = uxItemSize;
+            xReturn = &( xQueues[ x ] );
+            break;
+        }
+    }
+
+    return xReturn;
+}
+
+/*-----------------------------------------------------------*/
+
+void vQueueDelete( QueueHandle_t xQueue )
+{
+    ( ( FakeQueue_t * ) xQueue )->xInUse = pdFALSE;
+}
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueSend( QueueHandle_t xQueue,
+                       const void * const pvItemToQueue,
+                       TickType_t xTicksToWait )
+{
+    FakeQueue_t * pxQueue = ( FakeQueue_t * ) xQueue;
+    BaseType_t xReturn = pdFAIL;
+
+    /* Nothing else runs while the caller would wait, so a full queue stays full. */
+    ( void ) xTicksToWait;
+
+    if( pxQueue->uxCount < pxQueue->uxLength )
+    {
+        ( void ) memcpy( pxQueue->ucItems[ ( pxQueue->uxHead + pxQueue->uxCount ) % pxQueue->uxLength ],
+                         pvItemToQueue,
+                         pxQueue->uxItemSize );
+        pxQueue->uxCount++;
+        xReturn = pdPASS;
+    }
+
+    return xReturn;
+}
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueReceive( QueueHandle_t xQueue,
+                          void * const pvBuffer,
+                          TickType_t xTicksToWait )
+{
+    FakeQueue_t * pxQueue = ( FakeQueue_t * ) xQueue;
+    BaseType_t xReturn = pdFAIL;
+
+    if( pxQueue->uxCount > 0U )
+    {
+        ( void ) memcpy( pvBuffer, pxQueue->ucItems[ pxQueue->uxHead ], pxQueue->uxItemSize );
+        pxQueue->uxHead = ( pxQueue->uxHead + 1U ) % pxQueue->uxLength;
+        pxQueue->uxCount--;
+        xReturn = pdPASS;
+    }
+    else if( xTicksToWait == portMAX_DELAY )
+    {
+        /* Nothing would ever wake the task up.  Park it, vFakeRunTasks() runs
+         * it again from the start, which is only correct for tasks that keep
+         * no state across such a block. */
+        configASSERT( xInTask == pdTRUE );
+        longjmp( xTaskReturn, fakeTASK_BLOCKED );
+    }
+    else
+    {
+        xTickCount += xTicksToWait;
+    }
+
+    return xReturn;
+}
+
+/*-----------------------------------------------------------*/
+/* FreeRTOS+TCP. */
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvConnectionAnswered( Socket_t xSocket )
+{
+    return ( ( xSocket->xConnectStarted == pdTRUE ) &&
+             ( xSocket->eOutcome != eFakeSilent ) &&
+             ( ( xTickCount - xSocket->xConnectTime ) >= xSocket->xLatency ) ) ? pdTRUE : pdFALSE;
+}
+
+/*-----------------------------------------------------------*/
+
+uint16_t FreeRTOS_htons( uint16_t usIn )
+{
+    return ( uint16_t ) ( ( usIn << 8 ) | ( usIn >> 8 ) );
+}
+
+/*-----------------------------------------------------------*/
+
+Socket_t FreeRTOS_socket( BaseType_t xDomain,
+                          BaseType_t xType,
+                          BaseType_t xProtocol )
+{
+    size_t x;
+    Socket_t xReturn = FREERTOS_INVALID_SOCKET;
+
+    ( void ) xType;
+    ( void ) xProtocol;
+
+    for( x = 0; x < fakeMAX_SOCKETS; x++ )
+    {
+        if( xSockets[ x ].xInUse == pdFALSE )
+        {
+            xReturn = &( xSockets[ x ] );
+            xReturn->xInUse = pdTRUE;
+            xReturn->xFamily = xDomain;
+            xReturn->xReceiveTimeout = ipconfigSOCK_DEFAULT_RECEIVE_BLOCK_TIME;
+            break;
+        }
+    }
+
+    return xReturn;
+}
+
+/*-----------------------------------------------------------*/
+
+BaseType_t FreeRTOS_setsockopt( Socket_t xSocket,
+                                int32_t lLevel,
+                                int32_t lOptionName,
+                                const void * pvOptionValue,
+                                size_t uxOptionLength )
+{
+    ( void ) lLevel;
+
+    configASSERT( xSocket->xClosed == pdFALSE );
+
+    if( lOptionName == FREERTOS_SO_RCVTIMEO )
+    {
+        configASSERT( uxOptionLength == sizeof( TickType_t ) );
+        xSocket->xReceiveTimeout = *( ( const TickType_t * ) pvOptionValue );
+    }
+
+    return 0;
+}
+
+/*-----------------------------------------------------------*/
+
+BaseType_t FreeRTOS_connect( Socket_t xClientSocket,
+                             const struct freertos_sockaddr * pxAddress,
+                             socklen_t xAddressLength )
+{
+    size_t x;
+    BaseType_t xReturn;
+
+    ( void ) xAddressLength;
+
+    configASSERT( xClientSocket->xConnectStarted == pdFALSE );
+    configASSERT( pxAddress->sin_family == xClientSocket->xFamily );
+
+    xClientSocket->xConnectStarted = pdTRUE;
+    xClientSocket->xConnectTime = xTickCount;
+    xClientSocket->eOutcome = eFakeSilent;
+
+    if( pxAddress->sin_family == FREERTOS_AF_INET6 )
+    {
+        ( void ) memcpy( &( xClientSocket->ulAddress ), pxAddress->sin_address.xIP_IPv6.ucBytes, sizeof( uint32_t ) );
+    }
+    else
+    {
+        xClientSocket->ulAddress = pxAddress->sin_address.ulIP_IPv4;
+    }
+
+    for( x = 0; x < uxHostAddressCount; x++ )
+    {
+        if( ( xHostAddresses[ x ].xFamily == pxAddress->sin_family ) &&
+            ( xHostAddresses[ x ].ulAddress == xClientSocket->ulAddress ) )
+        {
+            xClientSocket->eOutcome = xHostAddresses[ x ].eOutcome;
+            xClientSocket->xLatency = xHostAddresses[ x ].xLatency;
+            break;
+        }
+    }
+
+    if( xClientSocket->xReceiveTimeout == 0U )
+    {
+        xReturn = -pdFREERTOS_ERRNO_EWOULDBLOCK;
+    }
+    else if( ( xClientSocket->eOutcome != eFakeSilent ) &&
+             ( xClientSocket->xLatency < xClientSocket->xReceiveTimeout ) )
+    {
+        xTickCount += xClientSocket->xLatency;
+        xReturn = ( xClientSocket->eOutcome == eFakeAccept ) ? 0 : -pdFREERTOS_ERRNO_ENOTCONN;
+        xClientSocket->xConnectedBlocking = ( xReturn == 0 ) ? pdTRUE : pdFALSE;
+    }
+    else
+    {
+        xTickCount += xClientSocket->xReceiveTimeout;
+        xReturn = -pdFREERTOS_ERRNO_ETIMEDOUT;
+    }
+
+    return xReturn;
+}
+
+/*-----------------------------------------------------------*/
+
+BaseType_t FreeRTOS_issocketconnected( Socket_t xSocket )
+{
+    return ( ( prvConnectionAnswered( xSocket ) == pdTRUE ) &&
+             ( xSocket->eOutcome == eFakeAccept ) ) ? pdTRUE : pdFALSE;
+}
+
+/*-----------------------------------------------------------*/
+
+BaseType_t FreeRTOS_connstatus( Socket_t xSocket )
+{
+    eIPTCPState_t eState = eCONNECT_SYN;
+
+    if( prvConnectionAnswered( xSocket ) == pdTRUE )
+    {
+        eState = ( xSocket->eOutcome == eFakeAccept ) ? eESTABLISHED : eCLOSED;
+    }
+
+    return ( BaseType_t ) eState;
+}
+
+/*-----------------------------------------------------------*/
+
+BaseType_t FreeRTOS_shutdown( Socket_t xSocket,
+                              BaseType_t xHow )
+{
+    ( void ) xHow;
+
+    configASSERT( xSocket->xClosed == pdFALSE );
+    xSocket->xShutdown = pdTRUE;
+    xSocket->xPeerCloseTime = ( xPeerCloseDelay == portMAX_DELAY ) ? portMAX_DELAY : ( xTickCount + xPeerCloseDelay );
+
+    return 0;
+}
+
+/*-----------------------------------------------------------*/
+
+BaseType_t FreeRTOS_closesocket( Socket_t xSocket )
+{
+    /* The slot is not reused before vFakeReset() so that tests can inspect
+     * closed sockets. */
+    configASSERT( xSocket->xClosed == pdFALSE );
+    xSocket->xClosed = pdTRUE;
+    xSocket->xCloseTime = xTickCount;
+
+    return 1;
+}
+
+/*-----------------------------------------------------------*/
+
+BaseType_t FreeRTOS_recv( Socket_t xSocket,
+                          void * pvBuffer,
+                          size_t uxBufferLength,
+                          BaseType_t xFlags )
+{
+    BaseType_t xReturn = 0;
+
+    ( void ) pvBuffer;
+    ( void ) uxBufferLength;
+    ( void ) xFlags;
+
+    configASSERT( xSocket->xClosed == pdFALSE );
+
+    /* The peer never sends data, it only closes its side after a shutdown. */
+    if( ( xSocket->xShutdown == pdTRUE ) && ( xSocket->xPeerCloseTime <= xTickCount ) )
+    {
+        xReturn = -pdFREERTOS_ERRNO_ENOTCONN;
+    }
+    else if( ( xSocket->xShutdown == pdTRUE ) && ( xSocket->xPeerCloseTime != portMAX_DELAY ) &&
+             ( ( xSocket->xPeerCloseTime - xTickCount ) <= xSocket->xReceiveTimeout ) )
+    {
+        xTickCount = xSocket->xPeerCloseTime;
+        xReturn = -pdFREERTOS_ERRNO_ENOTCONN;
+    }
+    else
+    {
+        xTickCount += xSocket->xReceiveTimeout;
+    }
+
+    return xReturn;
+}
+
+/*-----------------------------------------------------------*/
+
+BaseType_t FreeRTOS_send( Socket_t xSocket,
+                          const void * pvBuffer,
+                          size_t uxDataLength,
+                          BaseType_t xFlags )
+{
+    ( void ) pvBuffer;
+    ( void ) xFlags;
+
+    configASSERT( xSocket->xClosed == pdFALSE );
+
+    return ( BaseType_t ) uxDataLength;
+}
+
+/*-----------------------------------------------------------*/
+
+BaseType_t FreeRTOS_getaddrinfo( const char * pcName,
+                                 const char * pcService,
+                                 const struct freertos_addrinfo * pxHints,
+                                 struct freertos_addrinfo ** ppxResult )
+{
+    struct freertos_addrinfo ** ppxTail = ppxResult;
+    struct freertos_addrinfo * pxInfo;
+    size_t x;
+
+    ( void ) pcService;
+
+    uxLookupCount++;
+    *ppxResult = NULL;
+
+    for( x = 0; x < uxHostAddressCount; x++ )
+    {
+        if( ( strcmp( xHostAddresses[ x ].cHost, pcName ) == 0 ) &&
+            ( xHostAddresses[ x ].xFamily == pxHints->ai_family ) )
+        {
+            /* One allocation holds the result and its address. */
+            pxInfo = pvPortMalloc( sizeof( *pxInfo ) + sizeof( struct freertos_sockaddr ) );
+            configASSERT( pxInfo != NULL );
+            ( void ) memset( pxInfo, 0, sizeof( *pxInfo ) + sizeof( struct freertos_sockaddr ) );
+            pxInfo->ai_family = xHostAddresses[ x ].xFamily;
+            pxInfo->ai_addrlen = sizeof( struct freertos_sockaddr );
+            pxInfo->ai_addr = ( struct freertos_sockaddr * ) &( pxInfo[ 1 ] );
+            pxInfo->ai_addr->sin_family = ( uint8_t ) xHostAddresses[ x ].xFamily;
+
+            if( xHostAddresses[ x ].xFamily == FREERTOS_AF_INET6 )
+            {
+                ( void ) memcpy( pxInfo->ai_addr->sin_address.xIP_IPv6.ucBytes, &( xHostAddresses[ x ].ulAddress ), sizeof( uint32_t ) );
+            }
+            else
+            {
+                pxInfo->ai_addr->sin_address.ulIP_IPv4 = xHostAddresses[ x ].ulAddress;
+            }
+
+            *ppxTail = pxInfo;
+            ppxTail = &( pxInfo->ai_next );
+        }
+    }
+
+    return ( *ppxResult != NULL ) ? 0 : -pdFREERTOS_ERRNO_ENOENT;
+}
+
+/*-----------------------------------------------------------*/
+
+void FreeRTOS_freeaddrinfo( struct freertos_addrinfo * pxInfo )
+{
+    struct freertos_addrinfo * pxNext;
+
+    while( pxInfo != NULL )
+    {
+        pxNext = pxInfo->ai_next;
+        vPortFree( pxInfo );
+        pxInfo = pxNext;
+    }
+}
@@ -0,0 +1,80 @@
+/*
+ * FreeRTOS V202212.00
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Control interface of the fake kernel and FreeRTOS+TCP stack used by the
+ * host test of the sockets wrapper.
+ *
+ * Time only moves when the code under test blocks: vTaskDelay(), a timed
+ * xQueueReceive() or a blocking FreeRTOS_connect() or FreeRTOS_recv() advance
+ * the tick count by the time they would have waited.  Every address of a fake
+ * host accepts, refuses or ignores connections after a fixed latency.
+ */
+
+#ifndef FAKE_NETWORK_H
+#define FAKE_NETWORK_H
+
+#include "FreeRTOS.h"
+#include "FreeRTOS_Sockets.h"
+
+/* How an address answers a connection attempt. */
+typedef enum
+{
+    eFakeAccept, /* The connection is established after the latency. */
+    eFakeRefuse, /* The connection is reset after the latency. */
+    eFakeSilent  /* Nothing ever answers. */
+} FakeOutcome_t;
+
+/* Forget all hosts and sockets and reset the tick count.  Tasks and queues
+ * are kept, like the static state of the wrapper. */
+void vFakeReset( void );
+
+/* Add an address to the DNS records of pcHost, in resolution order. */
+void vFakeAddHostAddress( const char * pcHost,
+                          BaseType_t xFamily,
+                          uint32_t ulAddress,
+                          FakeOutcome_t eOutcome,
+                          TickType_t xLatency );
+
+/* Ticks after FreeRTOS_shutdown() at which the peer closes its side, or
+ * portMAX_DELAY for a peer that never does. */
+void vFakeSetPeerCloseDelay( TickType_t xDelay );
+
+/* Run the tasks created with xTaskCreate() until each one is deleted or blocks
+ * on an empty queue without a timeout. */
+void vFakeRunTasks( void );
+
+size_t uxFakeTaskCount( void );
+size_t uxFakeLookupCount( void );
+size_t uxFakeOpenSocketCount( void );
+size_t uxFakeLiveAllocationCount( void );
+
+uint32_t ulFakeSocketAddress( Socket_t xSocket );
+BaseType_t xFakeSocketConnectedBlocking( Socket_t xSocket );
+BaseType_t xFakeSocketClosed( Socket_t xSocket );
+TickType_t xFakeSocketCloseTime( Socket_t xSocket );
+
+#endif /* FAKE_NETWORK_H */
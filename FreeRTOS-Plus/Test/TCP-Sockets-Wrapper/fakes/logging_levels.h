@@ -0,0 +1,6 @@
+/* The wrapper logs through LogError() and friends, see logging_stack.h. */
+#define LOG_NONE     0
+#define LOG_ERROR    1
+#define LOG_WARN     2
+#define LOG_INFO     3
+#define LOG_DEBUG    4
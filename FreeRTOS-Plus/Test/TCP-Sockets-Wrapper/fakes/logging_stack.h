@@ -0,0 +1,5 @@
+/* Logging is compiled out of the host test. */
+#define LogError( message )
+#define LogWarn( message )
+#define LogInfo( message )
+#define LogDebug( message )
@@ -0,0 +1,497 @@
+/*
+ * FreeRTOS V202212.00
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Host test of the FreeRTOS+TCP port of the sockets wrapper.  It runs the
+ * wrapper against the fake kernel and network stack in fakes/, see
+ * fake_network.h.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Fake FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_Sockets.h"
+#include "fake_network.h"
+
+/* Unit under test. */
+#define SOCKET_T_TYPEDEFED
+#include "tcp_sockets_wrapper.h"
+
+/* The Makefile passes the same configuration to the wrapper. */
+#ifndef FREERTOS_SOCKETS_WRAPPER_DNS_CACHE_ENTRIES
+    #define FREERTOS_SOCKETS_WRAPPER_DNS_CACHE_ENTRIES    ( 0 )
+#endif
+
+#ifndef FREERTOS_SOCKETS_WRAPPER_CLOSE_POLICY
+    #define FREERTOS_SOCKETS_WRAPPER_CLOSE_POLICY    ( 0 )
+#endif
+
+/* Close policies of the wrapper. */
+#define testCLOSE_DRAIN              ( 0 )
+#define testCLOSE_LINGER             ( 1 )
+#define testCLOSE_REAPER             ( 2 )
+
+/* Defaults of the wrapper. */
+#define testATTEMPT_DELAY_TICKS      pdMS_TO_TICKS( 250U )
+#define testCONNECT_TIMEOUT_TICKS    ipconfigSOCK_DEFAULT_RECEIVE_BLOCK_TIME
+#define testPOLL_TICKS               pdMS_TO_TICKS( 10U )
+#define testSHUTDOWN_LOOPS           ( 3U )
+#define testLINGER_TICKS             pdMS_TO_TICKS( 1000U )
+#define testREAPER_POLL_TICKS        pdMS_TO_TICKS( 50U )
+#define testREAPER_QUEUE_LENGTH      ( 8U )
+
+#define testRECEIVE_TIMEOUT_MS       ( 100U )
+#define testSEND_TIMEOUT_MS          ( 100U )
+#define testPORT                     ( 8883U )
+
+#define testASSERT( x )                                              \
+    do {                                                             \
+        if( !( x ) )                                                 \
+        {                                                            \
+            printf( "%s:%d: FAILED: %s\n", __FILE__, __LINE__, # x ); \
+            ulTestFailures++;                                        \
+        }                                                            \
+    } while( 0 )
+
+typedef struct ConnectResult
+{
+    uint32_t ulCallbackCount;
+    BaseType_t xStatus;
+    Socket_t xSocket;
+    TCP_Sockets_ConnectTimings_t xTimings;
+} ConnectResult_t;
+
+static uint32_t ulTestFailures = 0;
+
+/*-----------------------------------------------------------*/
+
+static void prvConnectCallback( BaseType_t xConnectStatus,
+                                Socket_t xTcpSocket,
+                                const TCP_Sockets_ConnectTimings_t * pxTimings,
+                                void * pvCallbackContext )
+{
+    ConnectResult_t * pxResult = ( ConnectResult_t * ) pvCallbackContext;
+
+    pxResult->ulCallbackCount++;
+    pxResult->xStatus = xConnectStatus;
+    pxResult->xSocket = xTcpSocket;
+    pxResult->xTimings = *pxTimings;
+}
+
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvConnect( const char * pcHost,
+                              Socket_t * pxSocket )
+{
+    *pxSocket = NULL;
+
+    return TCP_Sockets_Connect( pxSocket, pcHost, testPORT, testRECEIVE_TIMEOUT_MS, testSEND_TIMEOUT_MS );
+}
+
+/* Disconnect and let the reaper task, if any, close the socket. */
+static void prvDisconnect( Socket_t xSocket )
+{
+    TCP_Sockets_Disconnect( xSocket );
+    vFakeRunTasks();
+}
+
+/*-----------------------------------------------------------*/
+
+/* A refused first address is abandoned as soon as the refusal arrives, without
+ * waiting for the attempt delay. */
+static void prvTestRefusedAddressFallsBack( void )
+{
+    Socket_t xSocket;
+
+    vFakeAddHostAddress( "refused.example", FREERTOS_AF_INET, 1U, eFakeRefuse, 20U );
+    vFakeAddHostAddress( "refused.example", FREERTOS_AF_INET, 2U, eFakeAccept, 30U );
+
+    testASSERT( prvConnect( "refused.example", &xSocket ) == 0 );
+    testASSERT( ulFakeSocketAddress( xSocket ) == 2U );
+    testASSERT( xTaskGetTickCount() < testATTEMPT_DELAY_TICKS );
+    testASSERT( uxFakeOpenSocketCount() == 1U );
+
+    prvDisconnect( xSocket );
+    testASSERT( uxFakeOpenSocketCount() == 0U );
+}
+
+/*-----------------------------------------------------------*/
+
+/* An unresponsive IPv6 address, tried first, delays the IPv4 attempt by the
+ * attempt delay only, and loses the race. */
+static void prvTestSilentAddressFallsBackAfterDelay( void )
+{
+    Socket_t xSocket;
+
+    vFakeAddHostAddress( "silent.example", FREERTOS_AF_INET6, 1U, eFakeSilent, 0U );
+    vFakeAddHostAddress( "silent.example", FREERTOS_AF_INET, 2U, eFakeAccept, 30U );
+
+    testASSERT( prvConnect( "silent.example", &xSocket ) == 0 );
+    testASSERT( ulFakeSocketAddress( xSocket ) == 2U );
+    testASSERT( xTaskGetTickCount() >= ( testATTEMPT_DELAY_TICKS + 30U ) );
+    testASSERT( xTaskGetTickCount() < ( testATTEMPT_DELAY_TICKS + 30U + testPOLL_TICKS ) );
+    testASSERT( xFakeSocketConnectedBlocking( xSocket ) == pdFALSE );
+
+    /* The IPv6 attempt was closed when the IPv4 one won. */
+    testASSERT( uxFakeOpenSocketCount() == 1U );
+
+    prvDisconnect( xSocket );
+}
+
+/*-----------------------------------------------------------*/
+
+/* Racing several unresponsive addresses takes as long as one blocking connect. */
+static void prvTestSilentAddressesTimeOut( void )
+{
+    Socket_t xSocket;
+
+    vFakeAddHostAddress( "down.example", FREERTOS_AF_INET, 1U, eFakeSilent, 0U );
+    vFakeAddHostAddress( "down.example", FREERTOS_AF_INET, 2U, eFakeSilent, 0U );
+
+    testASSERT( prvConnect( "down.example", &xSocket ) != 0 );
+    testASSERT( xSocket == NULL );
+    testASSERT( xTaskGetTickCount() >= testCONNECT_TIMEOUT_TICKS );
+    testASSERT( xTaskGetTickCount() < ( testCONNECT_TIMEOUT_TICKS + testPOLL_TICKS ) );
+    testASSERT( uxFakeOpenSocketCount() == 0U );
+}
+
+/*-----------------------------------------------------------*/
+
+/* A host with a single address is connected to with a blocking connect. */
+static void prvTestSingleAddressConnectsBlocking( void )
+{
+    Socket_t xSocket;
+
+    vFakeAddHostAddress( "single.example", FREERTOS_AF_INET, 1U, eFakeAccept, 30U );
+
+    testASSERT( prvConnect( "single.example", &xSocket ) == 0 );
+    testASSERT( xFakeSocketConnectedBlocking( xSocket ) == pdTRUE );
+    testASSERT( xTaskGetTickCount() == 30U );
+
+    prvDisconnect( xSocket );
+}
+
+/*-----------------------------------------------------------*/
+
+static void prvTestUnresolvedHostFails( void )
+{
+    Socket_t xSocket;
+
+    testASSERT( prvConnect( "unknown.example", &xSocket ) != 0 );
+    testASSERT( xSocket == NULL );
+    testASSERT( uxFakeOpenSocketCount() == 0U );
+}
+
+/*-----------------------------------------------------------*/
+
+/* The connection runs in its own task, which reports the winning address and
+ * the number of attempts, then frees its request. */
+static void prvTestAsyncConnectFallsBack( void )
+{
+    ConnectResult_t xResult = { 0 };
+    size_t uxTasks = uxFakeTaskCount();
+
+    vFakeAddHostAddress( "async.example", FREERTOS_AF_INET, 1U, eFakeRefuse, 20U );
+    vFakeAddHostAddress( "async.example", FREERTOS_AF_INET, 2U, eFakeAccept, 30U );
+
+    testASSERT( TCP_Sockets_ConnectAsync( "async.example", testPORT, testRECEIVE_TIMEOUT_MS,
+                                          testSEND_TIMEOUT_MS, prvConnectCallback, &xResult ) == 0 );
+    testASSERT( xResult.ulCallbackCount == 0U );
+    testASSERT( xTaskGetTickCount() == 0U );
+
+    vFakeRunTasks();
+
+    testASSERT( xResult.ulCallbackCount == 1U );
+    testASSERT( xResult.xStatus == 0 );
+    testASSERT( ulFakeSocketAddress( xResult.xSocket ) == 2U );
+    testASSERT( xResult.xTimings.addressesTried == 2 );
+    testASSERT( xResult.xTimings.dnsCacheHit == pdFALSE );
+    testASSERT( xResult.xTimings.totalTicks == xTaskGetTickCount() );
+    testASSERT( uxFakeTaskCount() == uxTasks );
+
+    prvDisconnect( xResult.xSocket );
+    testASSERT( uxFakeLiveAllocationCount() == 0U );
+}
+
+/*-----------------------------------------------------------*/
+
+static void prvTestAsyncConnectReportsFailure( void )
+{
+    ConnectResult_t xResult = { 0 };
+
+    vFakeAddHostAddress( "refusing.example", FREERTOS_AF_INET, 1U, eFakeRefuse, 20U );
+    vFakeAddHostAddress( "refusing.example", FREERTOS_AF_INET, 2U, eFakeRefuse, 20U );
+
+    testASSERT( TCP_Sockets_ConnectAsync( "refusing.example", testPORT, testRECEIVE_TIMEOUT_MS,
+                                          testSEND_TIMEOUT_MS, prvConnectCallback, &xResult ) == 0 );
+    vFakeRunTasks();
+
+    testASSERT( xResult.ulCallbackCount == 1U );
+    testASSERT( xResult.xStatus != 0 );
+    testASSERT( xResult.xSocket == NULL );
+    testASSERT( xResult.xTimings.addressesTried == 2 );
+    testASSERT( uxFakeOpenSocketCount() == 0U );
+    testASSERT( uxFakeLiveAllocationCount() == 0U );
+}
+
+/*-----------------------------------------------------------*/
+
+/* With the cache, a host name is resolved again only after a failed connect. */
+static void prvTestDnsCache( void )
+{
+    Socket_t xSocket;
+    size_t uxLookups;
+
+    vFakeAddHostAddress( "cached.example", FREERTOS_AF_INET, 1U, eFakeAccept, 10U );
+    vFakeAddHostAddress( "cached.example", FREERTOS_AF_INET, 2U, eFakeAccept, 10U );
+
+    testASSERT( prvConnect( "cached.example", &xSocket ) == 0 );
+    prvDisconnect( xSocket );
+    uxLookups = uxFakeLookupCount();
+    testASSERT( uxLookups > 0U );
+
+    testASSERT( prvConnect( "cached.example", &xSocket ) == 0 );
+    prvDisconnect( xSocket );
+
+    #if ( FREERTOS_SOCKETS_WRAPPER_DNS_CACHE_ENTRIES > 0 )
+    {
+        testASSERT( uxFakeLookupCount() == uxLookups );
+
+        /* The host moves, the cached addresses now refuse connections. */
+        vFakeReset();
+        vFakeAddHostAddress( "cached.example", FREERTOS_AF_INET, 1U, eFakeRefuse, 10U );
+        vFakeAddHostAddress( "cached.example", FREERTOS_AF_INET, 2U, eFakeRefuse, 10U );
+        testASSERT( prvConnect( "cached.example", &xSocket ) != 0 );
+        testASSERT( uxFakeLookupCount() == 0U );
+
+        testASSERT( prvConnect( "cached.example", &xSocket ) != 0 );
+        testASSERT( uxFakeLookupCount() > 0U );
+    }
+    #else
+    {
+        testASSERT( uxFakeLookupCount() == ( 2U * uxLookups ) );
+    }
+    #endif /* if ( FREERTOS_SOCKETS_WRAPPER_DNS_CACHE_ENTRIES > 0 ) */
+}
+
+/* Connect at tick 0 to a host with a single address. */
+static Socket_t prvConnectForClose( uint32_t ulReceiveTimeoutMs )
+{
+    Socket_t xSocket = NULL;
+
+    if( uxFakeOpenSocketCount() == 0U )
+    {
+        vFakeAddHostAddress( "close.example", FREERTOS_AF_INET, 1U, eFakeAccept, 0U );
+    }
+
+    testASSERT( TCP_Sockets_Connect( &xSocket, "close.example", testPORT, ulReceiveTimeoutMs, testSEND_TIMEOUT_MS ) == 0 );
+    testASSERT( xTaskGetTickCount() == 0U );
+
+    return xSocket;
+}
+
+/*-----------------------------------------------------------*/
+
+#if ( FREERTOS_SOCKETS_WRAPPER_CLOSE_POLICY == testCLOSE_DRAIN )
+
+/* The socket is closed as soon as the peer closes its side. */
+    static void prvTestDrainWaitsForPeer( void )
+    {
+        Socket_t xSocket = prvConnectForClose( testRECEIVE_TIMEOUT_MS );
+
+        vFakeSetPeerCloseDelay( 150U );
+        TCP_Sockets_Disconnect( xSocket );
+
+        testASSERT( xFakeSocketClosed( xSocket ) == pdTRUE );
+        testASSERT( xFakeSocketCloseTime( xSocket ) == 150U );
+    }
+
+/*-----------------------------------------------------------*/
+
+/* A peer that never closes is waited for a number of receive timeouts. */
+    static void prvTestDrainIsBoundedByReceiveTimeouts( void )
+    {
+        Socket_t xSocket = prvConnectForClose( testRECEIVE_TIMEOUT_MS );
+
+        vFakeSetPeerCloseDelay( portMAX_DELAY );
+        TCP_Sockets_Disconnect( xSocket );
+
+        testASSERT( xFakeSocketClosed( xSocket ) == pdTRUE );
+        testASSERT( xFakeSocketCloseTime( xSocket ) == ( testSHUTDOWN_LOOPS * pdMS_TO_TICKS( testRECEIVE_TIMEOUT_MS ) ) );
+    }
+
+#endif /* if ( FREERTOS_SOCKETS_WRAPPER_CLOSE_POLICY == testCLOSE_DRAIN ) */
+
+/*-----------------------------------------------------------*/
+
+#if ( FREERTOS_SOCKETS_WRAPPER_CLOSE_POLICY == testCLOSE_LINGER )
+
+    static void prvTestLingerWaitsForPeer( void )
+    {
+        Socket_t xSocket = prvConnectForClose( 5000U );
+
+        vFakeSetPeerCloseDelay( 200U );
+        TCP_Sockets_Disconnect( xSocket );
+
+        testASSERT( xFakeSocketClosed( xSocket ) == pdTRUE );
+        testASSERT( xFakeSocketCloseTime( xSocket ) == 200U );
+    }
+
+/*-----------------------------------------------------------*/
+
+/* The linger time bounds the wait, however long the receive timeout is. */
+    static void prvTestLingerIsBounded( void )
+    {
+        Socket_t xSocket = prvConnectForClose( 5000U );
+
+        vFakeSetPeerCloseDelay( portMAX_DELAY );
+        TCP_Sockets_Disconnect( xSocket );
+
+        testASSERT( xFakeSocketClosed( xSocket ) == pdTRUE );
+        testASSERT( xFakeSocketCloseTime( xSocket ) == testLINGER_TICKS );
+    }
+
+#endif /* if ( FREERTOS_SOCKETS_WRAPPER_CLOSE_POLICY == testCLOSE_LINGER ) */
+
+/*-----------------------------------------------------------*/
+
+#if ( FREERTOS_SOCKETS_WRAPPER_CLOSE_POLICY == testCLOSE_REAPER )
+
+/* The calling task does not block, the reaper closes the socket once the peer
+ * closes its side. */
+    static void prvTestReaperDoesNotBlock( void )
+    {
+        Socket_t xSocket = prvConnectForClose( 5000U );
+
+        vFakeSetPeerCloseDelay( 200U );
+        TCP_Sockets_Disconnect( xSocket );
+
+        testASSERT( xTaskGetTickCount() == 0U );
+        testASSERT( xFakeSocketClosed( xSocket ) == pdFALSE );
+
+        vFakeRunTasks();
+
+        testASSERT( xFakeSocketClosed( xSocket ) == pdTRUE );
+        testASSERT( xFakeSocketCloseTime( xSocket ) >= 200U );
+        testASSERT( xFakeSocketCloseTime( xSocket ) < ( 200U + testREAPER_POLL_TICKS ) );
+        testASSERT( uxFakeTaskCount() == 1U );
+    }
+
+/*-----------------------------------------------------------*/
+
+    static void prvTestReaperIsBounded( void )
+    {
+        Socket_t xSocket = prvConnectForClose( 5000U );
+
+        vFakeSetPeerCloseDelay( portMAX_DELAY );
+        TCP_Sockets_Disconnect( xSocket );
+        vFakeRunTasks();
+
+        testASSERT( xFakeSocketClosed( xSocket ) == pdTRUE );
+        testASSERT( xFakeSocketCloseTime( xSocket ) >= testLINGER_TICKS );
+        testASSERT( xFakeSocketCloseTime( xSocket ) < ( testLINGER_TICKS + testREAPER_POLL_TICKS ) );
+    }
+
+/*-----------------------------------------------------------*/
+
+/* A socket the reaper queue has no room for lingers in the calling task. */
+    static void prvTestReaperQueueFullLingers( void )
+    {
+        Socket_t xSockets[ testREAPER_QUEUE_LENGTH + 1U ];
+        size_t x;
+
+        for( x = 0; x < ( testREAPER_QUEUE_LENGTH + 1U ); x++ )
+        {
+            xSockets[ x ] = prvConnectForClose( 5000U );
+        }
+
+        vFakeSetPeerCloseDelay( portMAX_DELAY );
+
+        for( x = 0; x < ( testREAPER_QUEUE_LENGTH + 1U ); x++ )
+        {
+            TCP_Sockets_Disconnect( xSockets[ x ] );
+        }
+
+        for( x = 0; x < testREAPER_QUEUE_LENGTH; x++ )
+        {
+            testASSERT( xFakeSocketClosed( xSockets[ x ] ) == pdFALSE );
+        }
+
+        testASSERT( xFakeSocketClosed( xSockets[ testREAPER_QUEUE_LENGTH ] ) == pdTRUE );
+        testASSERT( xFakeSocketCloseTime( xSockets[ testREAPER_QUEUE_LENGTH ] ) == testLINGER_TICKS );
+
+        vFakeRunTasks();
+
+        testASSERT( uxFakeOpenSocketCount() == 0U );
+    }
+
+#endif /* if ( FREERTOS_SOCKETS_WRAPPER_CLOSE_POLICY == testCLOSE_REAPER ) */
+
+/*-----------------------------------------------------------*/
+
+static void prvRunTest( const char * pcName,
+                        void ( * pxTest )( void ) )
+{
+    uint32_t ulFailuresBefore = ulTestFailures;
+
+    vFakeReset();
+    vFakeSetPeerCloseDelay( 0U );
+    pxTest();
+
+    printf( "%s %s\n", ( ulTestFailures == ulFailuresBefore ) ? "PASS" : "FAIL", pcName );
+}
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    prvRunTest( "refused address falls back", prvTestRefusedAddressFallsBack );
+    prvRunTest( "silent address falls back after delay", prvTestSilentAddressFallsBackAfterDelay );
+    prvRunTest( "silent addresses time out", prvTestSilentAddressesTimeOut );
+    prvRunTest( "single address connects blocking", prvTestSingleAddressConnectsBlocking );
+    prvRunTest( "unresolved host fails", prvTestUnresolvedHostFails );
+    prvRunTest( "async connect falls back", prvTestAsyncConnectFallsBack );
+    prvRunTest( "async connect reports failure", prvTestAsyncConnectReportsFailure );
+    prvRunTest( "DNS cache", prvTestDnsCache );
+
+    #if ( FREERTOS_SOCKETS_WRAPPER_CLOSE_POLICY == testCLOSE_DRAIN )
+        prvRunTest( "drain waits for peer", prvTestDrainWaitsForPeer );
+        prvRunTest( "drain is bounded by receive timeouts", prvTestDrainIsBoundedByReceiveTimeouts );
+    #elif ( FREERTOS_SOCKETS_WRAPPER_CLOSE_POLICY == testCLOSE_LINGER )
+        prvRunTest( "linger waits for peer", prvTestLingerWaitsForPeer );
+        prvRunTest( "linger is bounded", prvTestLingerIsBounded );
+    #elif ( FREERTOS_SOCKETS_WRAPPER_CLOSE_POLICY == testCLOSE_REAPER )
+        prvRunTest( "reaper does not block", prvTestReaperDoesNotBlock );
+        prvRunTest( "reaper is bounded", prvTestReaperIsBounded );
+        prvRunTest( "reaper queue full lingers", prvTestReaperQueueFullLingers );
+    #endif
+
+    return ( ulTestFailures == 0U ) ? 0 : 1;
+}
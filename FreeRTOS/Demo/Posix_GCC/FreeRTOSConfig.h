@@ -44,7 +44,11 @@
 #define configUSE_DAEMON_TASK_STARTUP_HOOK         1
 #define configTICK_RATE_HZ                         ( 1000 )                  /* In this non-real time simulated environment the tick frequency has to be at least a multiple of the Win32 tick frequency, and therefore very slow. */
 #define configMINIMAL_STACK_SIZE                   ( PTHREAD_STACK_MIN ) /* The stack size being passed is equal to the minimum stack size needed by pthread_create(). */
-#define configTOTAL_HEAP_SIZE                      ( ( size_t ) ( 65 * 1024 ) )
+#if ( projUSE_TLSF_HEAP == 1 )
+    #define configTOTAL_HEAP_SIZE                  ( ( size_t ) ( 32 * 1024 * 1024 ) ) /* heap_tlsf.c also holds the pthread stacks, which are at least PTHREAD_STACK_MIN words each. */
+#else
+    #define configTOTAL_HEAP_SIZE                  ( ( size_t ) ( 65 * 1024 ) )
+#endif
 #define configMAX_TASK_NAME_LEN                    ( 12 )
 #define configUSE_TRACE_FACILITY                   1
 #define configUSE_16_BIT_TICKS                     0
@@ -89,8 +93,9 @@
 #define configMAX_PRIORITIES                       ( 7 )
 
 /* Run time stats gathering configuration options. */
-unsigned long ulGetRunTimeCounterValue( void ); /* Prototype of function that returns run time counter. */
-void vConfigureTimerForRunTimeStats( void );    /* Prototype of function that initialises the run time counter. */
+#define configRUN_TIME_COUNTER_TYPE               uint64_t
+configRUN_TIME_COUNTER_TYPE ulGetRunTimeCounterValue( void ); /* Prototype of function that returns run time counter. */
+void vConfigureTimerForRunTimeStats( void );                  /* Prototype of function that initialises the run time counter. */
 #define configGENERATE_RUN_TIME_STATS             1
 
 /* Co-routine related configuration options. */
@@ -179,6 +184,16 @@ extern void vAssertCalled( const char * const pcFileName,
     #endif /* if ( projENABLE_TRACING == 1 ) */
 #endif /* if ( projCOVERAGE_TEST == 1 ) */
 
+/* Map the kernel trace macros onto the in-tree ring buffer tracer. */
+#if ( projENABLE_RING_TRACE == 1 )
+    #include "ring_trace.h"
+#endif
+
+/* Record every allocation and free to a file for heap/heap_bench.c to replay. */
+#if ( projRECORD_HEAP_TRACE == 1 )
+    #include "heap_trace.h"
+#endif
+
 /* networking definitions */
 #define configMAC_ISR_SIMULATOR_PRIORITY    ( configMAX_PRIORITIES - 1 )
 
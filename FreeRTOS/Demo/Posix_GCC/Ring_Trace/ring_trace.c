@@ -0,0 +1,261 @@
+/*
+ * FreeRTOS V202212.00
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Storage, name registry and file output for the ring buffer tracer.  See
+ * ring_trace.h.
+ */
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if ( projENABLE_RING_TRACE == 1 )
+
+/* Written at the start of the dump file.  The version is incremented whenever
+ * the layout of the file changes. */
+    #define ringtraceFILE_MAGIC      "FRTRING"
+    #define ringtraceFILE_VERSION    1U
+
+/* Layout of the dump file, all fields in host byte order:
+ *
+ *   RingTraceFileHeader_t
+ *   RingTraceName_t        [ ulNumberOfNames ]
+ *   RingTraceBuffer_t      [ ulNumberOfCores ]
+ */
+    typedef struct RingTraceFileHeader
+    {
+        char cMagic[ 8 ];
+        uint32_t ulVersion;
+        uint32_t ulNumberOfCores;
+        uint32_t ulEventsPerCore;
+        uint32_t ulNumberOfNames;
+        uint64_t ullStartTimestamp; /* ullRingTraceTimestamp() when recording started. */
+        uint64_t ullStartNs;        /* CLOCK_MONOTONIC when recording started. */
+        uint64_t ullStopTimestamp;  /* ullRingTraceTimestamp() when recording stopped. */
+        uint64_t ullStopNs;         /* CLOCK_MONOTONIC when recording stopped. */
+    } RingTraceFileHeader_t;
+
+    typedef struct RingTraceName
+    {
+        uint64_t ullObject;
+        uint32_t ulKind;
+        uint32_t ulReserved;
+        char cName[ ringtraceNAME_LENGTH ];
+    } RingTraceName_t;
+
+/*-----------------------------------------------------------*/
+
+    RingTraceBuffer_t xRingTraceBuffers[ ringtraceNUMBER_OF_CORES ];
+    volatile uint32_t ulRingTraceEnabled = 0U;
+
+/* The registry holds one entry per object address.  ulNumberOfNames entries
+ * are in use, each either for a live object or for a deleted one.  Deleted
+ * entries keep their name so events still in the buffers can be labelled,
+ * and are reused, oldest deletion first, once every entry is in use.
+ * ulNameDeletedOrder[] is zero for a live object, otherwise the order in
+ * which it was deleted. */
+    static RingTraceName_t xNames[ ringtraceMAX_NAMES ];
+    static uint32_t ulNameDeletedOrder[ ringtraceMAX_NAMES ];
+    static uint32_t ulNumberOfNames = 0U;
+    static uint32_t ulNumberOfDeletions = 0U;
+    static RingTraceFileHeader_t xHeader;
+
+/*-----------------------------------------------------------*/
+
+    static uint64_t prvGetTimeNs( void )
+    {
+        struct timespec xNow;
+
+        clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+        return ( uint64_t ) xNow.tv_sec * 1000000000ULL + ( uint64_t ) xNow.tv_nsec;
+    }
+/*-----------------------------------------------------------*/
+
+    static int prvWriteAll( int iFile,
+                            const void * pvData,
+                            size_t xLength )
+    {
+        const uint8_t * pucData = ( const uint8_t * ) pvData;
+        ssize_t xWritten;
+
+        while( xLength > 0U )
+        {
+            xWritten = write( iFile, pucData, xLength );
+
+            if( xWritten <= 0 )
+            {
+                return -1;
+            }
+
+            pucData += xWritten;
+            xLength -= ( size_t ) xWritten;
+        }
+
+        return 0;
+    }
+/*-----------------------------------------------------------*/
+
+    void vRingTraceStart( void )
+    {
+        xHeader.ullStartNs = prvGetTimeNs();
+        xHeader.ullStartTimestamp = ullRingTraceTimestamp();
+        __atomic_store_n( &ulRingTraceEnabled, 1U, __ATOMIC_RELEASE );
+    }
+/*-----------------------------------------------------------*/
+
+    void vRingTraceStop( void )
+    {
+        if( __atomic_exchange_n( &ulRingTraceEnabled, 0U, __ATOMIC_ACQ_REL ) != 0U )
+        {
+            xHeader.ullStopTimestamp = ullRingTraceTimestamp();
+            xHeader.ullStopNs = prvGetTimeNs();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static uint32_t prvFindName( uint64_t ullObject )
+    {
+        uint32_t ulSlot;
+
+        for( ulSlot = 0U; ulSlot < ulNumberOfNames; ulSlot++ )
+        {
+            if( xNames[ ulSlot ].ullObject == ullObject )
+            {
+                break;
+            }
+        }
+
+        return ulSlot;
+    }
+/*-----------------------------------------------------------*/
+
+    void vRingTraceRegisterName( const void * pvObject,
+                                 uint32_t ulKind,
+                                 const char * pcName )
+    {
+        uint64_t ullObject = ( uint64_t ) ( uintptr_t ) pvObject;
+        uint32_t ulSlot, ulCandidate;
+
+        /* Names are registered and released when objects are created and
+         * deleted, which is not on any hot path, so a critical section is used
+         * to serialise access to the registry across cores. */
+        taskENTER_CRITICAL();
+        {
+            /* Memory freed by a deleted object is often reused for the next
+             * one, in which case its entry is taken over. */
+            ulSlot = prvFindName( ullObject );
+
+            if( ulSlot == ulNumberOfNames )
+            {
+                if( ulNumberOfNames < ringtraceMAX_NAMES )
+                {
+                    ulNumberOfNames++;
+                }
+                else
+                {
+                    /* Full, so reuse the entry deleted longest ago, if any. */
+                    ulSlot = ringtraceMAX_NAMES;
+
+                    for( ulCandidate = 0U; ulCandidate < ringtraceMAX_NAMES; ulCandidate++ )
+                    {
+                        if( ( ulNameDeletedOrder[ ulCandidate ] != 0U ) &&
+                            ( ( ulSlot == ringtraceMAX_NAMES ) || ( ulNameDeletedOrder[ ulCandidate ] < ulNameDeletedOrder[ ulSlot ] ) ) )
+                        {
+                            ulSlot = ulCandidate;
+                        }
+                    }
+                }
+            }
+
+            if( ulSlot < ringtraceMAX_NAMES )
+            {
+                xNames[ ulSlot ].ullObject = ullObject;
+                xNames[ ulSlot ].ulKind = ulKind;
+                ( void ) strncpy( xNames[ ulSlot ].cName, pcName, ringtraceNAME_LENGTH - 1U );
+                xNames[ ulSlot ].cName[ ringtraceNAME_LENGTH - 1U ] = '\0';
+                ulNameDeletedOrder[ ulSlot ] = 0U;
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    void vRingTraceReleaseName( const void * pvObject )
+    {
+        uint32_t ulSlot;
+
+        taskENTER_CRITICAL();
+        {
+            ulSlot = prvFindName( ( uint64_t ) ( uintptr_t ) pvObject );
+
+            if( ( ulSlot < ulNumberOfNames ) && ( ulNameDeletedOrder[ ulSlot ] == 0U ) )
+            {
+                ulNumberOfDeletions++;
+                ulNameDeletedOrder[ ulSlot ] = ulNumberOfDeletions;
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    int xRingTraceDump( const char * pcFileName )
+    {
+        int iFile;
+        int iReturn = -1;
+
+        vRingTraceStop();
+
+        ( void ) memcpy( xHeader.cMagic, ringtraceFILE_MAGIC, sizeof( ringtraceFILE_MAGIC ) );
+        xHeader.ulVersion = ringtraceFILE_VERSION;
+        xHeader.ulNumberOfCores = ringtraceNUMBER_OF_CORES;
+        xHeader.ulEventsPerCore = ringtraceEVENTS_PER_CORE;
+        xHeader.ulNumberOfNames = ulNumberOfNames;
+
+        iFile = open( pcFileName, O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+
+        if( iFile >= 0 )
+        {
+            if( ( prvWriteAll( iFile, &xHeader, sizeof( xHeader ) ) == 0 ) &&
+                ( prvWriteAll( iFile, xNames, xHeader.ulNumberOfNames * sizeof( RingTraceName_t ) ) == 0 ) &&
+                ( prvWriteAll( iFile, xRingTraceBuffers, sizeof( xRingTraceBuffers ) ) == 0 ) )
+            {
+                iReturn = 0;
+            }
+
+            ( void ) close( iFile );
+        }
+
+        return iReturn;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* projENABLE_RING_TRACE */
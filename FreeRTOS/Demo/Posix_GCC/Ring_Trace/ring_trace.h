@@ -0,0 +1,241 @@
+/*
+ * FreeRTOS V202212.00
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A lock-free binary event tracer for the Posix demo.
+ *
+ * Every core owns a ring buffer of fixed size events.  Recording an event
+ * claims a slot with a single relaxed atomic increment of the core's write
+ * index and fills it in place, so tracing never takes a lock, never enters a
+ * critical section and never makes a system call on hosts with a cycle
+ * counter.  Once a ring is full the oldest events are overwritten, so the
+ * buffers always hold the most recent history.
+ *
+ * The kernel's trace macros are mapped onto the tracer at the end of this
+ * file.  The ISR entry and exit macros are mapped too, but the Posix port
+ * never calls them, so those events only appear in traces of ports that do.
+ * xRingTraceDump() writes the buffers to a file that ring_trace_decode.py
+ * converts to the Chrome trace event JSON format, which can be opened in
+ * Perfetto or chrome://tracing.
+ *
+ * This header is included from FreeRTOSConfig.h, so it is seen by every kernel
+ * source file before any kernel type has been defined.
+ */
+
+#ifndef RING_TRACE_H
+#define RING_TRACE_H
+
+#include <stdint.h>
+#include <time.h>
+
+#if ( configUSE_TRACE_FACILITY != 1 )
+    #error The ring tracer needs configUSE_TRACE_FACILITY to be 1 to tell mutexes apart from queues
+#endif
+
+/* Number of events held per core.  Must be a power of two. */
+#ifndef ringtraceEVENTS_PER_CORE
+    #define ringtraceEVENTS_PER_CORE    16384U
+#endif
+
+/* Number of tasks and queues whose names can be recorded.  The entries of
+ * deleted objects are reused once all are in use, so this only limits the
+ * number of objects that exist at the same time. */
+#ifndef ringtraceMAX_NAMES
+    #define ringtraceMAX_NAMES    256U
+#endif
+
+#if ( ( ringtraceEVENTS_PER_CORE & ( ringtraceEVENTS_PER_CORE - 1U ) ) != 0U )
+    #error ringtraceEVENTS_PER_CORE must be a power of two
+#endif
+
+#ifdef configNUMBER_OF_CORES
+    #define ringtraceNUMBER_OF_CORES    configNUMBER_OF_CORES
+#else
+    #define ringtraceNUMBER_OF_CORES    1
+#endif
+
+/* Length of the names stored in the dump, including the terminator. */
+#define ringtraceNAME_LENGTH    16U
+
+/* Event types.  The values are part of the dump format and are mirrored in
+ * ring_trace_decode.py. */
+#define ringtraceEVENT_TASK_SWITCHED_IN          1U
+#define ringtraceEVENT_TASK_SWITCHED_OUT         2U
+#define ringtraceEVENT_TASK_DELETE               3U
+#define ringtraceEVENT_QUEUE_SEND                4U
+#define ringtraceEVENT_QUEUE_SEND_FAILED         5U
+#define ringtraceEVENT_QUEUE_RECEIVE             6U
+#define ringtraceEVENT_QUEUE_RECEIVE_FAILED      7U
+#define ringtraceEVENT_QUEUE_BLOCK_ON_SEND       8U
+#define ringtraceEVENT_QUEUE_BLOCK_ON_RECEIVE    9U
+#define ringtraceEVENT_MUTEX_CONTENDED           10U
+#define ringtraceEVENT_PRIORITY_INHERIT          11U
+#define ringtraceEVENT_ISR_ENTER                 12U
+#define ringtraceEVENT_ISR_EXIT                  13U
+
+/* Kinds of named objects. */
+#define ringtraceNAME_KIND_TASK     0U
+#define ringtraceNAME_KIND_QUEUE    1U
+
+/* One recorded event.  ullObject identifies the task or queue the event
+ * refers to and ulArgument carries an event specific value, such as a
+ * priority or the number of items in a queue. */
+typedef struct RingTraceEvent
+{
+    uint64_t ullTimestamp;
+    uint64_t ullObject;
+    uint32_t ulEventType;
+    uint32_t ulArgument;
+} RingTraceEvent_t;
+
+/* The ring buffer of one core.  ulWriteIndex counts every event ever
+ * recorded, the slot used is ulWriteIndex modulo ringtraceEVENTS_PER_CORE. */
+typedef struct RingTraceBuffer
+{
+    uint32_t ulWriteIndex;
+    uint32_t ulReserved;
+    RingTraceEvent_t xEvents[ ringtraceEVENTS_PER_CORE ];
+} RingTraceBuffer_t;
+
+extern RingTraceBuffer_t xRingTraceBuffers[ ringtraceNUMBER_OF_CORES ];
+extern volatile uint32_t ulRingTraceEnabled;
+
+/*
+ * Start recording events.  Events raised before this is called, or after
+ * vRingTraceStop() is called, are discarded.
+ */
+void vRingTraceStart( void );
+void vRingTraceStop( void );
+
+/*
+ * Record the name of a task or queue so the decoder can label its events.
+ */
+void vRingTraceRegisterName( const void * pvObject,
+                             uint32_t ulKind,
+                             const char * pcName );
+
+/*
+ * Mark the name of a deleted task or queue as reusable.  The name stays in the
+ * dump until its entry is needed for another object.
+ */
+void vRingTraceReleaseName( const void * pvObject );
+
+/*
+ * Stop recording and write the buffers to pcFileName.  Only uses async-signal
+ * safe calls, so can be called from a signal handler.  Returns 0 on success.
+ */
+int xRingTraceDump( const char * pcFileName );
+
+/*-----------------------------------------------------------*/
+
+/* The timestamp source.  The cycle counter is read where there is one, its
+ * frequency is recovered by the decoder from the start and dump times. */
+static inline uint64_t ullRingTraceTimestamp( void )
+{
+    #if defined( __x86_64__ ) || defined( __i386__ )
+        return __builtin_ia32_rdtsc();
+    #else
+        struct timespec xNow;
+
+        clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+        return ( uint64_t ) xNow.tv_sec * 1000000000ULL + ( uint64_t ) xNow.tv_nsec;
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+static inline void vRingTraceRecord( uint32_t ulCore,
+                                     uint32_t ulEventType,
+                                     uint64_t ullObject,
+                                     uint32_t ulArgument )
+{
+    RingTraceEvent_t * pxEvent;
+    uint32_t ulIndex;
+
+    if( ulRingTraceEnabled != 0U )
+    {
+        /* The increment is atomic so an interrupt that records an event on
+         * the same core between the claim and the writes below gets a
+         * different slot. */
+        ulIndex = __atomic_fetch_add( &( xRingTraceBuffers[ ulCore ].ulWriteIndex ), 1U, __ATOMIC_RELAXED );
+        pxEvent = &( xRingTraceBuffers[ ulCore ].xEvents[ ulIndex & ( ringtraceEVENTS_PER_CORE - 1U ) ] );
+
+        pxEvent->ullTimestamp = ullRingTraceTimestamp();
+        pxEvent->ullObject = ullObject;
+        pxEvent->ulEventType = ulEventType;
+        pxEvent->ulArgument = ulArgument;
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if ( ringtraceNUMBER_OF_CORES > 1 )
+    #define ringtraceCORE_ID()    ( ( uint32_t ) portGET_CORE_ID() )
+#else
+    #define ringtraceCORE_ID()    ( 0U )
+#endif
+
+#define ringtraceRECORD( ulEventType, pvObject, ulArgument ) \
+    vRingTraceRecord( ringtraceCORE_ID(), ( ulEventType ), ( uint64_t ) ( uintptr_t ) ( pvObject ), ( uint32_t ) ( ulArgument ) )
+
+#define ringtraceQUEUE_IS_MUTEX( pxQueue )                    \
+    ( ( ( pxQueue )->ucQueueType == queueQUEUE_TYPE_MUTEX ) || \
+      ( ( pxQueue )->ucQueueType == queueQUEUE_TYPE_RECURSIVE_MUTEX ) )
+
+/*-----------------------------------------------------------
+* Kernel trace macros.
+*----------------------------------------------------------*/
+
+#define traceTASK_SWITCHED_IN()                                    ringtraceRECORD( ringtraceEVENT_TASK_SWITCHED_IN, pxCurrentTCB, pxCurrentTCB->uxPriority )
+#define traceTASK_SWITCHED_OUT()                                   ringtraceRECORD( ringtraceEVENT_TASK_SWITCHED_OUT, pxCurrentTCB, pxCurrentTCB->uxPriority )
+#define traceTASK_CREATE( pxNewTCB )                               vRingTraceRegisterName( ( pxNewTCB ), ringtraceNAME_KIND_TASK, ( pxNewTCB )->pcTaskName )
+#define traceTASK_DELETE( pxTaskToDelete )                                      \
+    do {                                                                        \
+        ringtraceRECORD( ringtraceEVENT_TASK_DELETE, pxTaskToDelete, 0U );      \
+        vRingTraceReleaseName( pxTaskToDelete );                                \
+    } while( 0 )
+#define traceTASK_PRIORITY_INHERIT( pxTCBOfMutexHolder, uxPriority )    ringtraceRECORD( ringtraceEVENT_PRIORITY_INHERIT, pxTCBOfMutexHolder, uxPriority )
+
+#define traceQUEUE_REGISTRY_ADD( xQueue, pcQueueName )             vRingTraceRegisterName( ( xQueue ), ringtraceNAME_KIND_QUEUE, ( pcQueueName ) )
+#define traceQUEUE_DELETE( pxQueue )                               vRingTraceReleaseName( pxQueue )
+#define traceQUEUE_SEND( pxQueue )                                 ringtraceRECORD( ringtraceEVENT_QUEUE_SEND, pxQueue, ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_SEND_FROM_ISR( pxQueue )                        ringtraceRECORD( ringtraceEVENT_QUEUE_SEND, pxQueue, ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_SEND_FAILED( pxQueue )                          ringtraceRECORD( ringtraceEVENT_QUEUE_SEND_FAILED, pxQueue, ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue )                 ringtraceRECORD( ringtraceEVENT_QUEUE_SEND_FAILED, pxQueue, ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_RECEIVE( pxQueue )                              ringtraceRECORD( ringtraceEVENT_QUEUE_RECEIVE, pxQueue, ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_RECEIVE_FROM_ISR( pxQueue )                     ringtraceRECORD( ringtraceEVENT_QUEUE_RECEIVE, pxQueue, ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_RECEIVE_FAILED( pxQueue )                       ringtraceRECORD( ringtraceEVENT_QUEUE_RECEIVE_FAILED, pxQueue, ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue )              ringtraceRECORD( ringtraceEVENT_QUEUE_RECEIVE_FAILED, pxQueue, ( pxQueue )->uxMessagesWaiting )
+#define traceBLOCKING_ON_QUEUE_SEND( pxQueue )                     ringtraceRECORD( ringtraceEVENT_QUEUE_BLOCK_ON_SEND, pxQueue, ( pxQueue )->uxMessagesWaiting )
+#define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue )                                                                                  \
+    ringtraceRECORD( ringtraceQUEUE_IS_MUTEX( pxQueue ) ? ringtraceEVENT_MUTEX_CONTENDED : ringtraceEVENT_QUEUE_BLOCK_ON_RECEIVE, \
+                     pxQueue, ( pxQueue )->uxMessagesWaiting )
+
+/* Not called by the Posix port. */
+#define traceISR_ENTER()                                           ringtraceRECORD( ringtraceEVENT_ISR_ENTER, 0U, 0U )
+#define traceISR_EXIT()                                            ringtraceRECORD( ringtraceEVENT_ISR_EXIT, 0U, 0U )
+#define traceISR_EXIT_TO_SCHEDULER()                               ringtraceRECORD( ringtraceEVENT_ISR_EXIT, 0U, 1U )
+
+#endif /* RING_TRACE_H */
@@ -0,0 +1,180 @@
+#!/usr/bin/env python3
+"""
+Convert a dump written by xRingTraceDump() into the Chrome trace event JSON
+format, which can be loaded into https://ui.perfetto.dev or chrome://tracing.
+
+Usage: ring_trace_decode.py RingTrace.bin [-o trace.json]
+
+Each core is shown as one thread whose slices are the tasks that ran on it.
+Queue operations, mutex contention and priority inheritance are shown as
+instant events on the core they happened on.
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+# Must match ring_trace.h / ring_trace.c.
+FILE_MAGIC = b"FRTRING\0"
+FILE_VERSION = 1
+NAME_LENGTH = 16
+
+HEADER = struct.Struct("=8sIIII4Q")
+NAME = struct.Struct("=QII%ds" % NAME_LENGTH)
+BUFFER_HEAD = struct.Struct("=II")
+EVENT = struct.Struct("=QQII")
+
+TASK_SWITCHED_IN = 1
+TASK_SWITCHED_OUT = 2
+TASK_DELETE = 3
+QUEUE_SEND = 4
+QUEUE_SEND_FAILED = 5
+QUEUE_RECEIVE = 6
+QUEUE_RECEIVE_FAILED = 7
+QUEUE_BLOCK_ON_SEND = 8
+QUEUE_BLOCK_ON_RECEIVE = 9
+MUTEX_CONTENDED = 10
+PRIORITY_INHERIT = 11
+ISR_ENTER = 12
+ISR_EXIT = 13
+
+INSTANT_EVENT_NAMES = {
+    TASK_DELETE: "Task delete",
+    QUEUE_SEND: "Queue send",
+    QUEUE_SEND_FAILED: "Queue send failed",
+    QUEUE_RECEIVE: "Queue receive",
+    QUEUE_RECEIVE_FAILED: "Queue receive failed",
+    QUEUE_BLOCK_ON_SEND: "Block on queue send",
+    QUEUE_BLOCK_ON_RECEIVE: "Block on queue receive",
+    MUTEX_CONTENDED: "Mutex contended",
+    PRIORITY_INHERIT: "Priority inherit",
+}
+
+
+def read_dump(path):
+    with open(path, "rb") as f:
+        data = f.read()
+
+    (magic, version, cores, events_per_core, name_count,
+     start_ts, start_ns, stop_ts, stop_ns) = HEADER.unpack_from(data, 0)
+
+    if magic != FILE_MAGIC:
+        raise ValueError("%s is not a ring trace dump" % path)
+    if version != FILE_VERSION:
+        raise ValueError("unsupported dump version %d" % version)
+
+    offset = HEADER.size
+    names = {}
+    for _ in range(name_count):
+        obj, kind, _reserved, raw = NAME.unpack_from(data, offset)
+        offset += NAME.size
+        # Entries are keyed by address.  If an object was deleted and its
+        # memory reused, the entry holds the name of the most recent one.
+        names[obj] = raw.split(b"\0", 1)[0].decode("ascii", "replace")
+
+    # Convert timestamps to microseconds since the start of recording.
+    if stop_ts > start_ts and stop_ns > start_ns:
+        scale = (stop_ns - start_ns) / (stop_ts - start_ts) / 1000.0
+    else:
+        scale = 1.0 / 1000.0
+
+    per_core = []
+    for _ in range(cores):
+        write_index, _reserved = BUFFER_HEAD.unpack_from(data, offset)
+        offset += BUFFER_HEAD.size
+        slots = [EVENT.unpack_from(data, offset + i * EVENT.size)
+                 for i in range(events_per_core)]
+        offset += events_per_core * EVENT.size
+
+        # The write index counts every event recorded, so once the ring has
+        # wrapped the oldest surviving event is at write_index.
+        count = min(write_index, events_per_core)
+        first = write_index - count
+        events = []
+        for i in range(first, write_index):
+            ts, obj, event_type, arg = slots[i % events_per_core]
+            if event_type == 0 or ts < start_ts:
+                continue
+            events.append(((ts - start_ts) * scale, obj, event_type, arg))
+        events.sort(key=lambda e: e[0])
+        per_core.append(events)
+
+    return names, per_core
+
+
+def object_name(names, obj):
+    return names.get(obj, "0x%x" % obj)
+
+
+def to_chrome(names, per_core):
+    trace = []
+
+    for core, events in enumerate(per_core):
+        trace.append({"name": "thread_name", "ph": "M", "pid": 0, "tid": core,
+                      "args": {"name": "Core %d" % core}})
+
+        running = None
+        in_isr = False
+
+        for ts, obj, event_type, arg in events:
+            base = {"pid": 0, "tid": core, "ts": ts}
+
+            if event_type == TASK_SWITCHED_IN:
+                if running is not None:
+                    trace.append(dict(base, ph="E"))
+                running = obj
+                trace.append(dict(base, ph="B", name=object_name(names, obj),
+                                  args={"priority": arg}))
+            elif event_type == TASK_SWITCHED_OUT:
+                # The first switch out may belong to a task that was switched
+                # in before the oldest surviving event.
+                if running is not None:
+                    trace.append(dict(base, ph="E"))
+                running = None
+            elif event_type == ISR_ENTER:
+                in_isr = True
+                trace.append(dict(base, ph="B", name="ISR"))
+            elif event_type == ISR_EXIT:
+                if in_isr:
+                    trace.append(dict(base, ph="E"))
+                in_isr = False
+            elif event_type in INSTANT_EVENT_NAMES:
+                args = {"object": object_name(names, obj)}
+                if event_type == PRIORITY_INHERIT:
+                    args["priority"] = arg
+                else:
+                    args["items"] = arg
+                trace.append(dict(base, ph="i", s="t",
+                                  name=INSTANT_EVENT_NAMES[event_type],
+                                  args=args))
+
+        last_ts = events[-1][0] if events else 0.0
+        if in_isr:
+            trace.append({"pid": 0, "tid": core, "ts": last_ts, "ph": "E"})
+        if running is not None:
+            trace.append({"pid": 0, "tid": core, "ts": last_ts, "ph": "E"})
+
+    return {"traceEvents": trace, "displayTimeUnit": "ns"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("dump", help="file written by xRingTraceDump()")
+    parser.add_argument("-o", "--output", help="JSON output file, stdout if omitted")
+    args = parser.parse_args()
+
+    names, per_core = read_dump(args.dump)
+    chrome = to_chrome(names, per_core)
+
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(chrome, f)
+    else:
+        json.dump(chrome, sys.stdout)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,714 @@
+/*
+ * FreeRTOS V202212.00
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Host benchmark and stress test for the heap implementations.  heap/Makefile
+ * links this file with heap_tlsf.c and with the kernel's heap_4.c and
+ * heap_5.c, so each heap is built with the same FreeRTOSConfig.h and the same
+ * configTOTAL_HEAP_SIZE.
+ *
+ * Run with the name of a file recorded by a HEAP_TRACE=1 build of the demo
+ * (see heap_trace.h), the allocations and frees in the file are replayed in
+ * order.  Run without arguments, benchSTRESS_OPERATIONS random allocations and
+ * frees are made instead, every allocated block is filled and checked before it
+ * is freed and, for heap_tlsf.c, xPortCheckHeapIntegrity() is called every
+ * benchCHECK_INTERVAL operations.
+ *
+ * Either way the program then frees every block still allocated, checks the
+ * heap has returned to its initial free size, and writes one line of JSON:
+ *
+ * {"heap":"heap_4","operations":12345,"failed_mallocs":0,"malloc_mean_ns":..,
+ *  "malloc_p99_ns":..,"malloc_max_ns":..,"free_mean_ns":..,"free_p99_ns":..,
+ *  "free_max_ns":..,"worst_fragmentation":0.123,"min_ever_free_bytes":..}
+ *
+ * worst_fragmentation is the largest value of
+ * 1 - ( largest free block / free bytes ) seen when sampling
+ * vPortGetHeapStats() every benchSAMPLE_INTERVAL operations.  Latencies
+ * include the cost of reading the clock, and the maximums include any time the
+ * host took the thread off the CPU, so compare maximums over several runs.
+ *
+ * The program exits with a non zero status if any check fails.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#ifdef benchHEAP_TLSF
+    #include "heap_tlsf.h"
+#endif
+
+/* Name written to the "heap" field of the output. */
+#ifndef benchHEAP_NAME
+    #define benchHEAP_NAME    "heap"
+#endif
+
+/* Set to 1 for heaps, such as heap_5.c, that must be given their memory by
+ * vPortDefineHeapRegions() before the first allocation. */
+#ifndef benchDEFINE_HEAP_REGIONS
+    #define benchDEFINE_HEAP_REGIONS    0
+#endif
+
+#define benchSTRESS_OPERATIONS    1000000UL
+#define benchSTRESS_SLOTS         4096UL
+#define benchCHECK_INTERVAL       64UL
+#define benchSAMPLE_INTERVAL      256UL
+
+/* Marks a free that has no matching allocation in the trace. */
+#define benchNO_BLOCK             SIZE_MAX
+
+/* One allocation or free to be made.  For an allocation xBlock is the index of
+ * the block in pvBlocks[], for a free it is the index of the block allocated
+ * by the matching allocation. */
+typedef struct BenchOperation
+{
+    size_t xSize;
+    size_t xBlock;
+    BaseType_t xIsMalloc;
+} BenchOperation_t;
+
+typedef struct BenchLatency
+{
+    uint32_t * pulSamples;
+    size_t xCount;
+    uint64_t ullTotalNs;
+    uint64_t ullMaxNs;
+} BenchLatency_t;
+
+/* Maps the addresses in a trace file to block indexes.  Open addressing with
+ * linear probing, a zero key is an empty slot. */
+typedef struct BenchAddressMap
+{
+    uintptr_t * puxKeys;
+    size_t * pxValues;
+    size_t xMask;
+} BenchAddressMap_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Reads a trace file written by heap_trace.c into an array of operations.
+ */
+static BenchOperation_t * prvLoadTrace( const char * pcFileName,
+                                        size_t * pxNumberOfOperations,
+                                        size_t * pxNumberOfBlocks );
+
+/*
+ * Runs the operations in order, timing every call, and frees anything still
+ * allocated at the end.
+ */
+static BaseType_t prvReplay( const BenchOperation_t * pxOperations,
+                             size_t xNumberOfOperations,
+                             size_t xNumberOfBlocks );
+
+/*
+ * Makes random allocations and frees, checking block contents and, for
+ * heap_tlsf.c, the free lists as it goes.
+ */
+static BaseType_t prvStress( void );
+
+static void prvRecordLatency( BenchLatency_t * pxLatency,
+                              uint64_t ullNs );
+static void prvSampleFragmentation( void );
+static uint64_t prvNowNs( void );
+static BaseType_t prvCheckHeap( void );
+static void prvFreeSamples( void );
+static void prvPrintResults( size_t xNumberOfOperations );
+
+/*-----------------------------------------------------------*/
+
+#if ( benchDEFINE_HEAP_REGIONS == 1 )
+    static uint8_t ucHeapRegion[ configTOTAL_HEAP_SIZE ] __attribute__( ( aligned( portBYTE_ALIGNMENT ) ) );
+#endif
+
+static BenchLatency_t xMallocLatency, xFreeLatency;
+static size_t xFailedMallocs = 0U;
+static size_t xInitialFreeBytes = 0U;
+static double dWorstFragmentation = 0.0;
+
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char * argv[] )
+{
+    BenchOperation_t * pxOperations;
+    size_t xNumberOfOperations, xNumberOfBlocks;
+    BaseType_t xResult;
+    void * pv;
+
+    #if ( benchDEFINE_HEAP_REGIONS == 1 )
+    {
+        HeapRegion_t xHeapRegions[] =
+        {
+            { ucHeapRegion, sizeof( ucHeapRegion ) },
+            { NULL,         0                      }
+        };
+
+        vPortDefineHeapRegions( xHeapRegions );
+    }
+    #endif
+
+    /* The heaps other than heap_5.c initialise themselves on the first
+     * allocation, so make one before reading the initial free size. */
+    pv = pvPortMalloc( 1U );
+    vPortFree( pv );
+    xInitialFreeBytes = xPortGetFreeHeapSize();
+
+    if( argc > 1 )
+    {
+        pxOperations = prvLoadTrace( argv[ 1 ], &xNumberOfOperations, &xNumberOfBlocks );
+
+        if( pxOperations == NULL )
+        {
+            return EXIT_FAILURE;
+        }
+
+        xResult = prvReplay( pxOperations, xNumberOfOperations, xNumberOfBlocks );
+        free( pxOperations );
+    }
+    else
+    {
+        xNumberOfOperations = benchSTRESS_OPERATIONS;
+        xResult = prvStress();
+    }
+
+    if( prvCheckHeap() == pdFAIL )
+    {
+        xResult = pdFAIL;
+    }
+
+    if( xPortGetFreeHeapSize() != xInitialFreeBytes )
+    {
+        printf( "%s: %lu bytes free after freeing every block, expected %lu\r\n",
+                benchHEAP_NAME, ( unsigned long ) xPortGetFreeHeapSize(), ( unsigned long ) xInitialFreeBytes );
+        xResult = pdFAIL;
+    }
+
+    prvPrintResults( xNumberOfOperations );
+
+    return ( xResult == pdPASS ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvHashAddress( uintptr_t uxAddress )
+{
+    /* The low bits of an address are mostly alignment. */
+    return ( size_t ) ( ( ( uint64_t ) uxAddress * 0x9E3779B97F4A7C15ULL ) >> 20 );
+}
+/*-----------------------------------------------------------*/
+
+static BenchOperation_t * prvLoadTrace( const char * pcFileName,
+                                        size_t * pxNumberOfOperations,
+                                        size_t * pxNumberOfBlocks )
+{
+    FILE * pxFile;
+    BenchOperation_t * pxOperations = NULL;
+    BenchOperation_t * pxGrown;
+    BenchAddressMap_t xMap;
+    size_t xCapacity = 0U, xCount = 0U, xBlocks = 0U, xLine = 0U, xSlot, x;
+    uintptr_t uxAddress;
+    unsigned long ulAddress, ulSize;
+    char cLine[ 64 ];
+    BaseType_t xResult = pdPASS;
+
+    pxFile = fopen( pcFileName, "r" );
+
+    if( pxFile == NULL )
+    {
+        printf( "Cannot open %s\r\n", pcFileName );
+        return NULL;
+    }
+
+    /* First read the file, leaving the addresses in xBlock. */
+    while( ( xResult == pdPASS ) && ( fgets( cLine, sizeof( cLine ), pxFile ) != NULL ) )
+    {
+        xLine++;
+
+        if( xCount == xCapacity )
+        {
+            xCapacity = ( xCapacity == 0U ) ? 4096U : ( xCapacity * 2U );
+            pxGrown = realloc( pxOperations, xCapacity * sizeof( BenchOperation_t ) );
+
+            if( pxGrown == NULL )
+            {
+                printf( "Out of memory reading %s\r\n", pcFileName );
+                xResult = pdFAIL;
+                break;
+            }
+
+            pxOperations = pxGrown;
+        }
+
+        if( sscanf( cLine, "m %lx %lu", &ulAddress, &ulSize ) == 2 )
+        {
+            pxOperations[ xCount ].xIsMalloc = pdTRUE;
+            pxOperations[ xCount ].xSize = ( size_t ) ulSize;
+            pxOperations[ xCount ].xBlock = ( size_t ) ulAddress;
+            xCount++;
+            xBlocks++;
+        }
+        else if( sscanf( cLine, "f %lx", &ulAddress ) == 1 )
+        {
+            pxOperations[ xCount ].xIsMalloc = pdFALSE;
+            pxOperations[ xCount ].xSize = 0U;
+            pxOperations[ xCount ].xBlock = ( size_t ) ulAddress;
+            xCount++;
+        }
+        else
+        {
+            printf( "%s:%lu: unrecognised line\r\n", pcFileName, ( unsigned long ) xLine );
+            xResult = pdFAIL;
+        }
+    }
+
+    ( void ) fclose( pxFile );
+
+    /* Then replace the addresses with block indexes.  The map has at least
+     * twice as many slots as there are allocations, so it never fills even
+     * though freed slots are not reused. */
+    xMap.xMask = 1U;
+
+    while( xMap.xMask < ( xBlocks * 2U ) )
+    {
+        xMap.xMask <<= 1;
+    }
+
+    xMap.puxKeys = calloc( xMap.xMask, sizeof( uintptr_t ) );
+    xMap.pxValues = calloc( xMap.xMask, sizeof( size_t ) );
+    xMap.xMask--;
+
+    if( ( xMap.puxKeys == NULL ) || ( xMap.pxValues == NULL ) )
+    {
+        printf( "Out of memory reading %s\r\n", pcFileName );
+        xResult = pdFAIL;
+    }
+
+    xBlocks = 0U;
+
+    for( x = 0U; ( xResult == pdPASS ) && ( x < xCount ); x++ )
+    {
+        uxAddress = ( uintptr_t ) pxOperations[ x ].xBlock;
+
+        xSlot = prvHashAddress( uxAddress ) & xMap.xMask;
+
+        /* Stop at the live entry for the address, or at the first empty slot.
+         * Freed entries keep their key but hold benchNO_BLOCK. */
+        while( ( xMap.puxKeys[ xSlot ] != 0U ) &&
+               ( ( xMap.puxKeys[ xSlot ] != uxAddress ) || ( xMap.pxValues[ xSlot ] == benchNO_BLOCK ) ) )
+        {
+            xSlot = ( xSlot + 1U ) & xMap.xMask;
+        }
+
+        if( pxOperations[ x ].xIsMalloc == pdTRUE )
+        {
+            if( xMap.puxKeys[ xSlot ] != 0U )
+            {
+                printf( "%s: address %lx allocated twice\r\n", pcFileName, ( unsigned long ) uxAddress );
+                xResult = pdFAIL;
+            }
+            else
+            {
+                /* Claim a fresh slot rather than reusing a freed one, which
+                 * keeps the probe sequences of later entries intact. */
+                xMap.puxKeys[ xSlot ] = uxAddress;
+                xMap.pxValues[ xSlot ] = xBlocks;
+                pxOperations[ x ].xBlock = xBlocks;
+                xBlocks++;
+            }
+        }
+        else if( xMap.puxKeys[ xSlot ] != 0U )
+        {
+            pxOperations[ x ].xBlock = xMap.pxValues[ xSlot ];
+            xMap.pxValues[ xSlot ] = benchNO_BLOCK;
+        }
+        else
+        {
+            /* Freed before the recording started. */
+            pxOperations[ x ].xBlock = benchNO_BLOCK;
+        }
+    }
+
+    free( xMap.puxKeys );
+    free( xMap.pxValues );
+
+    if( xResult == pdFAIL )
+    {
+        free( pxOperations );
+        pxOperations = NULL;
+    }
+
+    *pxNumberOfOperations = xCount;
+    *pxNumberOfBlocks = xBlocks;
+
+    return pxOperations;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvReplay( const BenchOperation_t * pxOperations,
+                             size_t xNumberOfOperations,
+                             size_t xNumberOfBlocks )
+{
+    void ** pvBlocks;
+    uint64_t ullStart;
+    size_t x;
+
+    pvBlocks = calloc( xNumberOfBlocks + 1U, sizeof( void * ) );
+    xMallocLatency.pulSamples = malloc( ( xNumberOfOperations + 1U ) * sizeof( uint32_t ) );
+    xFreeLatency.pulSamples = malloc( ( xNumberOfOperations + 1U ) * sizeof( uint32_t ) );
+
+    if( ( pvBlocks == NULL ) || ( xMallocLatency.pulSamples == NULL ) || ( xFreeLatency.pulSamples == NULL ) )
+    {
+        printf( "Out of memory\r\n" );
+        free( pvBlocks );
+        prvFreeSamples();
+        return pdFAIL;
+    }
+
+    for( x = 0U; x < xNumberOfOperations; x++ )
+    {
+        if( pxOperations[ x ].xIsMalloc == pdTRUE )
+        {
+            ullStart = prvNowNs();
+            pvBlocks[ pxOperations[ x ].xBlock ] = pvPortMalloc( pxOperations[ x ].xSize );
+            prvRecordLatency( &xMallocLatency, prvNowNs() - ullStart );
+
+            if( pvBlocks[ pxOperations[ x ].xBlock ] == NULL )
+            {
+                xFailedMallocs++;
+            }
+        }
+        else if( ( pxOperations[ x ].xBlock != benchNO_BLOCK ) && ( pvBlocks[ pxOperations[ x ].xBlock ] != NULL ) )
+        {
+            ullStart = prvNowNs();
+            vPortFree( pvBlocks[ pxOperations[ x ].xBlock ] );
+            prvRecordLatency( &xFreeLatency, prvNowNs() - ullStart );
+
+            pvBlocks[ pxOperations[ x ].xBlock ] = NULL;
+        }
+
+        if( ( x % benchSAMPLE_INTERVAL ) == 0U )
+        {
+            prvSampleFragmentation();
+        }
+    }
+
+    prvSampleFragmentation();
+
+    for( x = 0U; x < xNumberOfBlocks; x++ )
+    {
+        vPortFree( pvBlocks[ x ] );
+    }
+
+    free( pvBlocks );
+
+    return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvStress( void )
+{
+    static uint8_t * pucBlocks[ benchSTRESS_SLOTS ];
+    static size_t xSizes[ benchSTRESS_SLOTS ];
+    uint64_t ullStart, ullRandom = 0x2545F4914F6CDD1DULL;
+    size_t x, xSlot, xByte;
+    BaseType_t xResult = pdPASS;
+
+    xMallocLatency.pulSamples = malloc( benchSTRESS_OPERATIONS * sizeof( uint32_t ) );
+    xFreeLatency.pulSamples = malloc( benchSTRESS_OPERATIONS * sizeof( uint32_t ) );
+
+    if( ( xMallocLatency.pulSamples == NULL ) || ( xFreeLatency.pulSamples == NULL ) )
+    {
+        printf( "Out of memory\r\n" );
+        prvFreeSamples();
+        return pdFAIL;
+    }
+
+    for( x = 0U; ( xResult == pdPASS ) && ( x < benchSTRESS_OPERATIONS ); x++ )
+    {
+        /* xorshift64, seeded so every heap sees the same sequence. */
+        ullRandom ^= ullRandom << 13;
+        ullRandom ^= ullRandom >> 7;
+        ullRandom ^= ullRandom << 17;
+
+        xSlot = ( size_t ) ( ullRandom % benchSTRESS_SLOTS );
+
+        if( pucBlocks[ xSlot ] != NULL )
+        {
+            for( xByte = 0U; xByte < xSizes[ xSlot ]; xByte++ )
+            {
+                if( pucBlocks[ xSlot ][ xByte ] != ( uint8_t ) xSlot )
+                {
+                    printf( "%s: block %lu overwritten\r\n", benchHEAP_NAME, ( unsigned long ) xSlot );
+                    xResult = pdFAIL;
+                    break;
+                }
+            }
+
+            ullStart = prvNowNs();
+            vPortFree( pucBlocks[ xSlot ] );
+            prvRecordLatency( &xFreeLatency, prvNowNs() - ullStart );
+
+            pucBlocks[ xSlot ] = NULL;
+        }
+        else
+        {
+            /* Mostly small blocks, some up to a few kilobytes and the odd
+             * large one, so every first level size class gets used. */
+            switch( ( ullRandom >> 32 ) % 64U )
+            {
+                case 0:
+                    xSizes[ xSlot ] = 1U + ( size_t ) ( ( ullRandom >> 40 ) % 65536U );
+                    break;
+
+                case 1:
+                case 2:
+                case 3:
+                case 4:
+                case 5:
+                case 6:
+                case 7:
+                    xSizes[ xSlot ] = 1U + ( size_t ) ( ( ullRandom >> 40 ) % 4096U );
+                    break;
+
+                default:
+                    xSizes[ xSlot ] = 1U + ( size_t ) ( ( ullRandom >> 40 ) % 128U );
+                    break;
+            }
+
+            ullStart = prvNowNs();
+            pucBlocks[ xSlot ] = pvPortMalloc( xSizes[ xSlot ] );
+            prvRecordLatency( &xMallocLatency, prvNowNs() - ullStart );
+
+            if( pucBlocks[ xSlot ] != NULL )
+            {
+                memset( pucBlocks[ xSlot ], ( int ) ( uint8_t ) xSlot, xSizes[ xSlot ] );
+            }
+            else
+            {
+                xFailedMallocs++;
+            }
+        }
+
+        if( ( x % benchSAMPLE_INTERVAL ) == 0U )
+        {
+            prvSampleFragmentation();
+        }
+
+        if( ( ( x % benchCHECK_INTERVAL ) == 0U ) && ( prvCheckHeap() == pdFAIL ) )
+        {
+            printf( "%s: heap inconsistent after operation %lu\r\n", benchHEAP_NAME, ( unsigned long ) x );
+            xResult = pdFAIL;
+        }
+    }
+
+    prvSampleFragmentation();
+
+    for( xSlot = 0U; xSlot < benchSTRESS_SLOTS; xSlot++ )
+    {
+        vPortFree( pucBlocks[ xSlot ] );
+        pucBlocks[ xSlot ] = NULL;
+    }
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCheckHeap( void )
+{
+    BaseType_t xResult = pdPASS;
+    HeapStats_t xHeapStats;
+
+    vPortGetHeapStats( &xHeapStats );
+
+    if( ( xHeapStats.xAvailableHeapSpaceInBytes != xPortGetFreeHeapSize() ) ||
+        ( xHeapStats.xMinimumEverFreeBytesRemaining > xHeapStats.xAvailableHeapSpaceInBytes ) ||
+        ( xHeapStats.xSizeOfLargestFreeBlockInBytes > xHeapStats.xAvailableHeapSpaceInBytes ) )
+    {
+        xResult = pdFAIL;
+    }
+
+    #if ( defined( benchHEAP_TLSF ) && ( heapTLSF_INTEGRITY_CHECK == 1 ) )
+    {
+        if( xPortCheckHeapIntegrity() == pdFAIL )
+        {
+            xResult = pdFAIL;
+        }
+    }
+    #endif
+
+    return xResult;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSampleFragmentation( void )
+{
+    HeapStats_t xHeapStats;
+    double dFragmentation;
+
+    vPortGetHeapStats( &xHeapStats );
+
+    if( xHeapStats.xAvailableHeapSpaceInBytes > 0U )
+    {
+        dFragmentation = 1.0 - ( ( double ) xHeapStats.xSizeOfLargestFreeBlockInBytes /
+                                 ( double ) xHeapStats.xAvailableHeapSpaceInBytes );
+
+        if( dFragmentation > dWorstFragmentation )
+        {
+            dWorstFragmentation = dFragmentation;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecordLatency( BenchLatency_t * pxLatency,
+                              uint64_t ullNs )
+{
+    pxLatency->pulSamples[ pxLatency->xCount ] = ( ullNs > UINT32_MAX ) ? UINT32_MAX : ( uint32_t ) ullNs;
+    pxLatency->xCount++;
+    pxLatency->ullTotalNs += ullNs;
+
+    if( ullNs > pxLatency->ullMaxNs )
+    {
+        pxLatency->ullMaxNs = ullNs;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static int prvCompareSamples( const void * pv1,
+                              const void * pv2 )
+{
+    uint32_t ul1 = *( const uint32_t * ) pv1, ul2 = *( const uint32_t * ) pv2;
+
+    return ( ul1 > ul2 ) - ( ul1 < ul2 );
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvPercentile99( BenchLatency_t * pxLatency )
+{
+    uint32_t ulReturn = 0U;
+
+    if( pxLatency->xCount > 0U )
+    {
+        qsort( pxLatency->pulSamples, pxLatency->xCount, sizeof( uint32_t ), prvCompareSamples );
+        ulReturn = pxLatency->pulSamples[ ( pxLatency->xCount * 99U ) / 100U ];
+    }
+
+    return ulReturn;
+}
+/*-----------------------------------------------------------*/
+
+static double prvMean( const BenchLatency_t * pxLatency )
+{
+    return ( pxLatency->xCount > 0U ) ? ( ( double ) pxLatency->ullTotalNs / ( double ) pxLatency->xCount ) : 0.0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintResults( size_t xNumberOfOperations )
+{
+    HeapStats_t xHeapStats;
+
+    vPortGetHeapStats( &xHeapStats );
+
+    printf( "{\"heap\":\"%s\",\"operations\":%lu,\"failed_mallocs\":%lu,"
+            "\"malloc_mean_ns\":%.1f,\"malloc_p99_ns\":%lu,\"malloc_max_ns\":%llu,"
+            "\"free_mean_ns\":%.1f,\"free_p99_ns\":%lu,\"free_max_ns\":%llu,"
+            "\"worst_fragmentation\":%.3f,\"min_ever_free_bytes\":%lu}\r\n",
+            benchHEAP_NAME,
+            ( unsigned long ) xNumberOfOperations,
+            ( unsigned long ) xFailedMallocs,
+            prvMean( &xMallocLatency ),
+            ( unsigned long ) prvPercentile99( &xMallocLatency ),
+            ( unsigned long long ) xMallocLatency.ullMaxNs,
+            prvMean( &xFreeLatency ),
+            ( unsigned long ) prvPercentile99( &xFreeLatency ),
+            ( unsigned long long ) xFreeLatency.ullMaxNs,
+            dWorstFragmentation,
+            ( unsigned long ) xHeapStats.xMinimumEverFreeBytesRemaining );
+
+    prvFreeSamples();
+}
+/*-----------------------------------------------------------*/
+
+static void prvFreeSamples( void )
+{
+    free( xMallocLatency.pulSamples );
+    xMallocLatency.pulSamples = NULL;
+    free( xFreeLatency.pulSamples );
+    xFreeLatency.pulSamples = NULL;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvNowNs( void )
+{
+    struct timespec xNow;
+
+    ( void ) clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+    return ( ( uint64_t ) xNow.tv_sec * 1000000000ULL ) + ( uint64_t ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+/* The heaps suspend the scheduler around every operation, but there is no
+ * scheduler here. */
+void vTaskSuspendAll( void )
+{
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskResumeAll( void )
+{
+    return pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical( void )
+{
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationMallocFailedHook( void )
+{
+    /* Failures are counted by the caller. */
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( const char * const pcFileName,
+                    unsigned long ulLine )
+{
+    printf( "ASSERT! Line %lu, file %s\r\n", ulLine, pcFileName );
+    exit( EXIT_FAILURE );
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,945 @@
+/*
+ * FreeRTOS V202212.00
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A two level segregated fit (TLSF) implementation of pvPortMalloc() and
+ * vPortFree() whose execution time does not depend on the number of blocks
+ * in the heap.
+ *
+ * Free blocks are kept on one list per size class.  The first level splits
+ * sizes into power of two ranges, the second level splits each range into
+ * 2^heapTLSF_SL_INDEX_COUNT_LOG2 linear subranges.  A bitmap per level records
+ * which lists are non-empty, so finding a free block that is large enough
+ * takes two find-first-set operations rather than a walk of the free list as
+ * done by heap_4.c and heap_5.c.  Adjacent free blocks are coalesced on
+ * vPortFree() in constant time using the physical neighbour links kept in
+ * every block header.
+ *
+ * As with heap_5.c, vPortDefineHeapRegions() can be called before the first
+ * allocation to spread the heap across several non-contiguous regions.  If it
+ * is not called, the heap is a single array of configTOTAL_HEAP_SIZE bytes,
+ * which the application can provide by setting configAPPLICATION_ALLOCATED_HEAP
+ * to 1, as with heap_4.c.
+ *
+ * See heap_1.c, heap_2.c, heap_3.c, heap_4.c and heap_5.c for alternative
+ * implementations, and the memory management pages of https://www.FreeRTOS.org
+ * for more information.
+ */
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "heap_tlsf.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+    #error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#if ( heapTLSF_FL_INDEX_COUNT > 32 )
+    #error heapTLSF_FL_INDEX_COUNT must not exceed 32 as the first level bitmap is 32 bits wide
+#endif
+
+#ifndef configHEAP_CLEAR_MEMORY_ON_FREE
+    #define configHEAP_CLEAR_MEMORY_ON_FREE    0
+#endif
+
+/* Block sizes are multiples of the granularity, which leaves the low bits of
+ * the size free to hold flags.  The granularity is at least 4 so one of those
+ * bits is always available. */
+#if ( portBYTE_ALIGNMENT >= 64 )
+    #define heapGRANULARITY_LOG2    6
+#elif ( portBYTE_ALIGNMENT == 32 )
+    #define heapGRANULARITY_LOG2    5
+#elif ( portBYTE_ALIGNMENT == 16 )
+    #define heapGRANULARITY_LOG2    4
+#elif ( portBYTE_ALIGNMENT == 8 )
+    #define heapGRANULARITY_LOG2    3
+#else
+    #define heapGRANULARITY_LOG2    2
+#endif
+
+#define heapGRANULARITY         ( ( size_t ) 1 << heapGRANULARITY_LOG2 )
+#define heapGRANULARITY_MASK    ( heapGRANULARITY - ( size_t ) 1 )
+
+/* Set in xBlockSize while a block is on a free list. */
+#define heapBLOCK_FREE_BIT      ( ( size_t ) 1 )
+
+/* Second level lists per first level size range. */
+#define heapSL_INDEX_COUNT      ( ( UBaseType_t ) 1 << heapTLSF_SL_INDEX_COUNT_LOG2 )
+
+/* Blocks smaller than this all map to the first first-level range, which is
+ * split linearly in steps of the granularity. */
+#define heapFL_INDEX_SHIFT      ( heapTLSF_SL_INDEX_COUNT_LOG2 + heapGRANULARITY_LOG2 )
+#define heapSMALL_BLOCK_SIZE    ( ( size_t ) 1 << heapFL_INDEX_SHIFT )
+
+/* Largest block size that maps to a valid size class. */
+#define heapMAXIMUM_BLOCK_SIZE                                                                  \
+    ( ( ( size_t ) 1 << ( heapFL_INDEX_SHIFT + heapTLSF_FL_INDEX_COUNT - 1 ) ) - heapGRANULARITY )
+
+#define heapADD_WILL_OVERFLOW( a, b )    ( ( a ) > ( SIZE_MAX - ( b ) ) )
+
+/*-----------------------------------------------------------*/
+
+/* Header at the start of every block.  The free list links are only valid
+ * while the block is free, and overlay the first bytes of the payload while it
+ * is allocated. */
+typedef struct A_BLOCK_HEADER
+{
+    struct A_BLOCK_HEADER * pxPrevPhysBlock; /* The block immediately before this one in memory, NULL for the first block of a region. */
+    size_t xBlockSize;                       /* Size of the payload in bytes, ORed with heapBLOCK_FREE_BIT. */
+    struct A_BLOCK_HEADER * pxNextFreeBlock; /* Next block on the same free list. */
+    struct A_BLOCK_HEADER * pxPrevFreeBlock; /* Previous block on the same free list. */
+} BlockHeader_t;
+
+/* Bytes of header in front of every payload, rounded up so payloads stay
+ * aligned. */
+static const size_t xHeapStructSize = ( offsetof( BlockHeader_t, pxNextFreeBlock ) + heapGRANULARITY_MASK ) & ~heapGRANULARITY_MASK;
+
+/* Smallest payload, which must be able to hold the free list links. */
+static const size_t xMinimumPayloadSize = ( ( sizeof( BlockHeader_t ) - offsetof( BlockHeader_t, pxNextFreeBlock ) ) + heapGRANULARITY_MASK ) & ~heapGRANULARITY_MASK;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Map a block size onto the free list it is stored on.
+ */
+static void prvMappingInsert( size_t xSize,
+                              UBaseType_t * puxFLIndex,
+                              UBaseType_t * puxSLIndex );
+
+/*
+ * Map a requested size onto the first free list whose blocks are all large
+ * enough to satisfy the request.
+ */
+static void prvMappingSearch( size_t xSize,
+                              UBaseType_t * puxFLIndex,
+                              UBaseType_t * puxSLIndex );
+
+/*
+ * Remove and return a free block of at least xSize payload bytes, or NULL if
+ * there is none.
+ */
+static BlockHeader_t * prvTakeSuitableBlock( size_t xSize );
+
+/*
+ * Link a block onto, or unlink it from, the free list for its size.
+ */
+static void prvInsertFreeBlock( BlockHeader_t * pxBlock );
+static void prvRemoveFreeBlock( BlockHeader_t * pxBlock );
+
+/*
+ * Split pxBlock so its payload is xSize bytes and return the remainder to the
+ * free lists, if the remainder is large enough to be a block of its own.
+ */
+static void prvTrimBlock( BlockHeader_t * pxBlock,
+                          size_t xSize );
+
+/*
+ * Merge the free block pxNext, which must follow pxBlock in memory, into
+ * pxBlock.
+ */
+static void prvMergeWithNext( BlockHeader_t * pxBlock,
+                              BlockHeader_t * pxNext );
+
+/*
+ * Add a region of memory to the heap.
+ */
+static void prvAddRegion( uint8_t * pucStartAddress,
+                          size_t xSizeInBytes );
+
+/*
+ * Called automatically to set up the heap on the first call to
+ * pvPortMalloc() if vPortDefineHeapRegions() has not been called.
+ */
+static void prvHeapInit( void );
+
+/*-----------------------------------------------------------*/
+
+/* Bit N is set if any second level list of first level range N is not
+ * empty. */
+PRIVILEGED_DATA static uint32_t ulFLBitmap = 0U;
+
+/* Bit M of entry N is set if the free list [ N ][ M ] is not empty. */
+PRIVILEGED_DATA static uint32_t ulSLBitmap[ heapTLSF_FL_INDEX_COUNT ];
+
+/* Heads of the free lists. */
+PRIVILEGED_DATA static BlockHeader_t * pxFreeLists[ heapTLSF_FL_INDEX_COUNT ][ heapSL_INDEX_COUNT ];
+
+/* Keeps track of the number of calls to allocate and free memory as well as the
+ * number of free bytes remaining, but says nothing about fragmentation.  The
+ * free bytes and free blocks are the totals of the free lists, and are only
+ * updated by prvInsertFreeBlock() and prvRemoveFreeBlock(). */
+PRIVILEGED_DATA static size_t xFreeBytesRemaining = 0U;
+PRIVILEGED_DATA static size_t xMinimumEverFreeBytesRemaining = 0U;
+PRIVILEGED_DATA static size_t xNumberOfFreeBlocks = 0U;
+PRIVILEGED_DATA static size_t xNumberOfSuccessfulAllocations = 0U;
+PRIVILEGED_DATA static size_t xNumberOfSuccessfulFrees = 0U;
+
+PRIVILEGED_DATA static BaseType_t xHeapHasBeenInitialised = pdFALSE;
+
+#if ( heapTLSF_SIZE_CLASS_STATS == 1 )
+    PRIVILEGED_DATA static HeapSizeClassStats_t xSizeClassStats[ heapTLSF_FL_INDEX_COUNT ];
+#endif
+
+/*-----------------------------------------------------------*/
+
+#if defined( __GNUC__ )
+    #define heapFIND_FIRST_SET( ulBitmap )    ( ( UBaseType_t ) __builtin_ctz( ulBitmap ) )
+    #define heapFIND_LAST_SET( xSize )        ( ( UBaseType_t ) ( ( sizeof( unsigned long long ) * 8U ) - 1U - ( size_t ) __builtin_clzll( ( unsigned long long ) ( xSize ) ) ) )
+#else
+
+/* Generic versions for compilers without bit scan intrinsics.  Both are only
+ * called with a non-zero argument. */
+    static UBaseType_t prvFindFirstSet( uint32_t ulBitmap )
+    {
+        UBaseType_t uxBit = 0U;
+
+        while( ( ulBitmap & ( ( uint32_t ) 1U << uxBit ) ) == 0U )
+        {
+            uxBit++;
+        }
+
+        return uxBit;
+    }
+
+    static UBaseType_t prvFindLastSet( size_t xSize )
+    {
+        UBaseType_t uxBit = 0U;
+
+        while( ( xSize >> 1 ) != 0U )
+        {
+            xSize >>= 1;
+            uxBit++;
+        }
+
+        return uxBit;
+    }
+
+    #define heapFIND_FIRST_SET( ulBitmap )    prvFindFirstSet( ulBitmap )
+    #define heapFIND_LAST_SET( xSize )        prvFindLastSet( xSize )
+#endif /* if defined( __GNUC__ ) */
+
+#define heapBLOCK_SIZE( pxBlock )    ( ( pxBlock )->xBlockSize & ~heapBLOCK_FREE_BIT )
+#define heapBLOCK_IS_FREE( pxBlock )    ( ( ( pxBlock )->xBlockSize & heapBLOCK_FREE_BIT ) != 0U )
+#define heapNEXT_PHYS_BLOCK( pxBlock ) \
+    ( ( BlockHeader_t * ) ( ( ( uint8_t * ) ( pxBlock ) ) + xHeapStructSize + heapBLOCK_SIZE( pxBlock ) ) )
+
+/*-----------------------------------------------------------*/
+
+void * pvPortMalloc( size_t xWantedSize )
+{
+    BlockHeader_t * pxBlock;
+    void * pvReturn = NULL;
+
+    if( xWantedSize > 0U )
+    {
+        /* Round the request up to the granularity, and up to the minimum
+         * payload so the block can hold the free list links once freed. */
+        if( heapADD_WILL_OVERFLOW( xWantedSize, heapGRANULARITY_MASK ) == 0 )
+        {
+            xWantedSize = ( xWantedSize + heapGRANULARITY_MASK ) & ~heapGRANULARITY_MASK;
+
+            if( xWantedSize < xMinimumPayloadSize )
+            {
+                xWantedSize = xMinimumPayloadSize;
+            }
+        }
+        else
+        {
+            xWantedSize = 0U;
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    vTaskSuspendAll();
+    {
+        if( xHeapHasBeenInitialised == pdFALSE )
+        {
+            prvHeapInit();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( ( xWantedSize > 0U ) && ( xWantedSize <= heapMAXIMUM_BLOCK_SIZE ) )
+        {
+            pxBlock = prvTakeSuitableBlock( xWantedSize );
+
+            if( pxBlock != NULL )
+            {
+                /* Return whatever is left over beyond the request to the
+                 * free lists.  xFreeBytesRemaining is kept up to date by the
+                 * free list functions, so it drops by the size of the block
+                 * plus the header of the remainder, if one was split off. */
+                prvTrimBlock( pxBlock, xWantedSize );
+
+                if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                {
+                    xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                #if ( heapTLSF_SIZE_CLASS_STATS == 1 )
+                {
+                    UBaseType_t uxFLIndex, uxSLIndex;
+
+                    prvMappingInsert( heapBLOCK_SIZE( pxBlock ), &uxFLIndex, &uxSLIndex );
+                    xSizeClassStats[ uxFLIndex ].xNumberOfSuccessfulAllocations++;
+                }
+                #endif
+
+                xNumberOfSuccessfulAllocations++;
+                pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceMALLOC( pvReturn, xWantedSize );
+    }
+    ( void ) xTaskResumeAll();
+
+    #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+    {
+        if( pvReturn == NULL )
+        {
+            vApplicationMallocFailedHook();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* if ( configUSE_MALLOC_FAILED_HOOK == 1 ) */
+
+    configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void * pv )
+{
+    BlockHeader_t * pxBlock;
+    BlockHeader_t * pxNeighbour;
+
+    if( pv != NULL )
+    {
+        pxBlock = ( BlockHeader_t * ) ( ( ( uint8_t * ) pv ) - xHeapStructSize );
+
+        /* The block must be allocated. */
+        configASSERT( heapBLOCK_IS_FREE( pxBlock ) == pdFALSE );
+
+        if( heapBLOCK_IS_FREE( pxBlock ) == pdFALSE )
+        {
+            #if ( configHEAP_CLEAR_MEMORY_ON_FREE == 1 )
+            {
+                ( void ) memset( pv, 0, heapBLOCK_SIZE( pxBlock ) );
+            }
+            #endif
+
+            vTaskSuspendAll();
+            {
+                traceFREE( pv, heapBLOCK_SIZE( pxBlock ) );
+
+                /* Coalesce with the following block, then with the preceding
+                 * one, so the heap never holds two adjacent free blocks. */
+                pxNeighbour = heapNEXT_PHYS_BLOCK( pxBlock );
+
+                if( heapBLOCK_IS_FREE( pxNeighbour ) != pdFALSE )
+                {
+                    prvRemoveFreeBlock( pxNeighbour );
+                    prvMergeWithNext( pxBlock, pxNeighbour );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxNeighbour = pxBlock->pxPrevPhysBlock;
+
+                if( ( pxNeighbour != NULL ) && ( heapBLOCK_IS_FREE( pxNeighbour ) != pdFALSE ) )
+                {
+                    prvRemoveFreeBlock( pxNeighbour );
+                    prvMergeWithNext( pxNeighbour, pxBlock );
+                    pxBlock = pxNeighbour;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                prvInsertFreeBlock( pxBlock );
+                xNumberOfSuccessfulFrees++;
+            }
+            ( void ) xTaskResumeAll();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortCalloc( size_t xNum,
+                     size_t xSize )
+{
+    void * pv = NULL;
+
+    if( ( xSize == 0U ) || ( xNum <= ( SIZE_MAX / xSize ) ) )
+    {
+        pv = pvPortMalloc( xNum * xSize );
+
+        if( pv != NULL )
+        {
+            ( void ) memset( pv, 0, xNum * xSize );
+        }
+    }
+
+    return pv;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+    return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+    return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+    /* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions )
+{
+    const HeapRegion_t * pxHeapRegion;
+
+    /* Can only call once! */
+    configASSERT( xHeapHasBeenInitialised == pdFALSE );
+
+    for( pxHeapRegion = pxHeapRegions; pxHeapRegion->xSizeInBytes > 0U; pxHeapRegion++ )
+    {
+        prvAddRegion( pxHeapRegion->pucStartAddress, pxHeapRegion->xSizeInBytes );
+    }
+
+    xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+    xHeapHasBeenInitialised = pdTRUE;
+
+    /* Check something was actually defined. */
+    configASSERT( xFreeBytesRemaining > 0U );
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t * pxHeapStats )
+{
+    BlockHeader_t * pxBlock;
+    size_t xMaxSize = 0U, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+    UBaseType_t uxFLIndex, uxSLIndex;
+
+    vTaskSuspendAll();
+    {
+        /* The smallest and largest free blocks are on the lowest and highest
+         * non-empty lists, so only those two lists need to be walked. */
+        if( ulFLBitmap != 0U )
+        {
+            uxFLIndex = heapFIND_FIRST_SET( ulFLBitmap );
+            uxSLIndex = heapFIND_FIRST_SET( ulSLBitmap[ uxFLIndex ] );
+
+            for( pxBlock = pxFreeLists[ uxFLIndex ][ uxSLIndex ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+            {
+                if( heapBLOCK_SIZE( pxBlock ) < xMinSize )
+                {
+                    xMinSize = heapBLOCK_SIZE( pxBlock );
+                }
+            }
+
+            uxFLIndex = heapFIND_LAST_SET( ulFLBitmap );
+            uxSLIndex = heapFIND_LAST_SET( ulSLBitmap[ uxFLIndex ] );
+
+            for( pxBlock = pxFreeLists[ uxFLIndex ][ uxSLIndex ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+            {
+                if( heapBLOCK_SIZE( pxBlock ) > xMaxSize )
+                {
+                    xMaxSize = heapBLOCK_SIZE( pxBlock );
+                }
+            }
+        }
+        else
+        {
+            xMinSize = 0U;
+        }
+
+        pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+        pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+        pxHeapStats->xNumberOfFreeBlocks = xNumberOfFreeBlocks;
+        pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+        pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+        pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+    }
+    ( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+#if ( heapTLSF_SIZE_CLASS_STATS == 1 )
+
+    void vPortGetHeapSizeClassStats( HeapSizeClassStats_t * pxStats )
+    {
+        vTaskSuspendAll();
+        {
+            ( void ) memcpy( pxStats, xSizeClassStats, sizeof( xSizeClassStats ) );
+        }
+        ( void ) xTaskResumeAll();
+    }
+
+#endif /* heapTLSF_SIZE_CLASS_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( heapTLSF_INTEGRITY_CHECK == 1 )
+
+    BaseType_t xPortCheckHeapIntegrity( void )
+    {
+        BaseType_t xReturn = pdPASS;
+        BlockHeader_t * pxBlock;
+        BlockHeader_t * pxPrevious;
+        UBaseType_t uxFLIndex, uxSLIndex, uxMappedFLIndex, uxMappedSLIndex;
+        size_t xFreeBytes = 0U, xFreeBlocks = 0U;
+
+        #if ( heapTLSF_SIZE_CLASS_STATS == 1 )
+            size_t xClassFreeBytes, xClassFreeBlocks;
+        #endif
+
+        vTaskSuspendAll();
+        {
+            for( uxFLIndex = 0U; uxFLIndex < heapTLSF_FL_INDEX_COUNT; uxFLIndex++ )
+            {
+                #if ( heapTLSF_SIZE_CLASS_STATS == 1 )
+                    xClassFreeBytes = 0U;
+                    xClassFreeBlocks = 0U;
+                #endif
+
+                /* A first level bit is set when any of its second level bits
+                 * is. */
+                if( ( ( ulFLBitmap & ( ( uint32_t ) 1U << uxFLIndex ) ) != 0U ) != ( ulSLBitmap[ uxFLIndex ] != 0U ) )
+                {
+                    xReturn = pdFAIL;
+                }
+
+                for( uxSLIndex = 0U; uxSLIndex < heapSL_INDEX_COUNT; uxSLIndex++ )
+                {
+                    if( ( pxFreeLists[ uxFLIndex ][ uxSLIndex ] != NULL ) != ( ( ulSLBitmap[ uxFLIndex ] & ( ( uint32_t ) 1U << uxSLIndex ) ) != 0U ) )
+                    {
+                        xReturn = pdFAIL;
+                    }
+
+                    pxPrevious = NULL;
+
+                    /* Bound the walk so a corrupted list cannot loop forever. */
+                    for( pxBlock = pxFreeLists[ uxFLIndex ][ uxSLIndex ];
+                         ( pxBlock != NULL ) && ( xFreeBlocks <= xNumberOfFreeBlocks );
+                         pxBlock = pxBlock->pxNextFreeBlock )
+                    {
+                        prvMappingInsert( heapBLOCK_SIZE( pxBlock ), &uxMappedFLIndex, &uxMappedSLIndex );
+
+                        if( ( heapBLOCK_IS_FREE( pxBlock ) == pdFALSE ) ||
+                            ( uxMappedFLIndex != uxFLIndex ) ||
+                            ( uxMappedSLIndex != uxSLIndex ) ||
+                            ( pxBlock->pxPrevFreeBlock != pxPrevious ) ||
+                            ( heapNEXT_PHYS_BLOCK( pxBlock )->pxPrevPhysBlock != pxBlock ) ||
+                            ( heapBLOCK_IS_FREE( heapNEXT_PHYS_BLOCK( pxBlock ) ) != pdFALSE ) ||
+                            ( ( pxBlock->pxPrevPhysBlock != NULL ) && ( heapBLOCK_IS_FREE( pxBlock->pxPrevPhysBlock ) != pdFALSE ) ) )
+                        {
+                            xReturn = pdFAIL;
+                        }
+
+                        xFreeBytes += heapBLOCK_SIZE( pxBlock );
+                        xFreeBlocks++;
+
+                        #if ( heapTLSF_SIZE_CLASS_STATS == 1 )
+                            xClassFreeBytes += heapBLOCK_SIZE( pxBlock );
+                            xClassFreeBlocks++;
+                        #endif
+
+                        pxPrevious = pxBlock;
+                    }
+                }
+
+                #if ( heapTLSF_SIZE_CLASS_STATS == 1 )
+                {
+                    if( ( xClassFreeBytes != xSizeClassStats[ uxFLIndex ].xFreeBytes ) ||
+                        ( xClassFreeBlocks != xSizeClassStats[ uxFLIndex ].xNumberOfFreeBlocks ) )
+                    {
+                        xReturn = pdFAIL;
+                    }
+                }
+                #endif
+            }
+
+            if( ( xFreeBytes != xFreeBytesRemaining ) ||
+                ( xFreeBlocks != xNumberOfFreeBlocks ) ||
+                ( xMinimumEverFreeBytesRemaining > xFreeBytesRemaining ) )
+            {
+                xReturn = pdFAIL;
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        return xReturn;
+    }
+
+#endif /* heapTLSF_INTEGRITY_CHECK */
+/*-----------------------------------------------------------*/
+
+static void prvMappingInsert( size_t xSize,
+                              UBaseType_t * puxFLIndex,
+                              UBaseType_t * puxSLIndex )
+{
+    UBaseType_t uxFLIndex, uxSLIndex;
+
+    if( xSize < heapSMALL_BLOCK_SIZE )
+    {
+        /* Small blocks are spread linearly over the first range. */
+        uxFLIndex = 0U;
+        uxSLIndex = ( UBaseType_t ) ( xSize >> heapGRANULARITY_LOG2 );
+    }
+    else
+    {
+        uxFLIndex = heapFIND_LAST_SET( xSize );
+        uxSLIndex = ( UBaseType_t ) ( ( xSize >> ( uxFLIndex - heapTLSF_SL_INDEX_COUNT_LOG2 ) ) ^ heapSL_INDEX_COUNT );
+        uxFLIndex -= ( heapFL_INDEX_SHIFT - 1U );
+    }
+
+    *puxFLIndex = uxFLIndex;
+    *puxSLIndex = uxSLIndex;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMappingSearch( size_t xSize,
+                              UBaseType_t * puxFLIndex,
+                              UBaseType_t * puxSLIndex )
+{
+    /* Blocks on a list can be up to one subrange smaller than the sizes that
+     * map to the next list, so round up to the start of the next subrange to
+     * guarantee that any block found is large enough. */
+    if( xSize >= heapSMALL_BLOCK_SIZE )
+    {
+        xSize += ( ( size_t ) 1 << ( heapFIND_LAST_SET( xSize ) - heapTLSF_SL_INDEX_COUNT_LOG2 ) ) - 1U;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    prvMappingInsert( xSize, puxFLIndex, puxSLIndex );
+}
+/*-----------------------------------------------------------*/
+
+static BlockHeader_t * prvTakeSuitableBlock( size_t xSize )
+{
+    BlockHeader_t * pxBlock = NULL;
+    UBaseType_t uxFLIndex, uxSLIndex;
+    uint32_t ulBitmap;
+
+    prvMappingSearch( xSize, &uxFLIndex, &uxSLIndex );
+
+    if( uxFLIndex < heapTLSF_FL_INDEX_COUNT )
+    {
+        /* Look for a non-empty list in the same range first, then fall back
+         * to the smallest non-empty list of any larger range. */
+        ulBitmap = ulSLBitmap[ uxFLIndex ] & ( ~( uint32_t ) 0U << uxSLIndex );
+
+        if( ulBitmap == 0U )
+        {
+            ulBitmap = ( uxFLIndex + 1U < 32U ) ? ( ulFLBitmap & ( ~( uint32_t ) 0U << ( uxFLIndex + 1U ) ) ) : 0U;
+
+            if( ulBitmap != 0U )
+            {
+                uxFLIndex = heapFIND_FIRST_SET( ulBitmap );
+                ulBitmap = ulSLBitmap[ uxFLIndex ];
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( ulBitmap != 0U )
+        {
+            uxSLIndex = heapFIND_FIRST_SET( ulBitmap );
+            pxBlock = pxFreeLists[ uxFLIndex ][ uxSLIndex ];
+            configASSERT( heapBLOCK_SIZE( pxBlock ) >= xSize );
+            prvRemoveFreeBlock( pxBlock );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertFreeBlock( BlockHeader_t * pxBlock )
+{
+    UBaseType_t uxFLIndex, uxSLIndex;
+    BlockHeader_t * pxHead;
+
+    prvMappingInsert( heapBLOCK_SIZE( pxBlock ), &uxFLIndex, &uxSLIndex );
+    pxHead = pxFreeLists[ uxFLIndex ][ uxSLIndex ];
+
+    pxBlock->xBlockSize |= heapBLOCK_FREE_BIT;
+    pxBlock->pxPrevFreeBlock = NULL;
+    pxBlock->pxNextFreeBlock = pxHead;
+
+    if( pxHead != NULL )
+    {
+        pxHead->pxPrevFreeBlock = pxBlock;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    pxFreeLists[ uxFLIndex ][ uxSLIndex ] = pxBlock;
+    ulFLBitmap |= ( uint32_t ) 1U << uxFLIndex;
+    ulSLBitmap[ uxFLIndex ] |= ( uint32_t ) 1U << uxSLIndex;
+    xNumberOfFreeBlocks++;
+    xFreeBytesRemaining += heapBLOCK_SIZE( pxBlock );
+
+    #if ( heapTLSF_SIZE_CLASS_STATS == 1 )
+    {
+        xSizeClassStats[ uxFLIndex ].xNumberOfFreeBlocks++;
+        xSizeClassStats[ uxFLIndex ].xFreeBytes += heapBLOCK_SIZE( pxBlock );
+    }
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveFreeBlock( BlockHeader_t * pxBlock )
+{
+    UBaseType_t uxFLIndex, uxSLIndex;
+
+    prvMappingInsert( heapBLOCK_SIZE( pxBlock ), &uxFLIndex, &uxSLIndex );
+
+    if( pxBlock->pxNextFreeBlock != NULL )
+    {
+        pxBlock->pxNextFreeBlock->pxPrevFreeBlock = pxBlock->pxPrevFreeBlock;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( pxBlock->pxPrevFreeBlock != NULL )
+    {
+        pxBlock->pxPrevFreeBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+    }
+    else
+    {
+        /* The block was the head of its list. */
+        pxFreeLists[ uxFLIndex ][ uxSLIndex ] = pxBlock->pxNextFreeBlock;
+
+        if( pxBlock->pxNextFreeBlock == NULL )
+        {
+            ulSLBitmap[ uxFLIndex ] &= ~( ( uint32_t ) 1U << uxSLIndex );
+
+            if( ulSLBitmap[ uxFLIndex ] == 0U )
+            {
+                ulFLBitmap &= ~( ( uint32_t ) 1U << uxFLIndex );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    pxBlock->xBlockSize &= ~heapBLOCK_FREE_BIT;
+    xNumberOfFreeBlocks--;
+    xFreeBytesRemaining -= heapBLOCK_SIZE( pxBlock );
+
+    #if ( heapTLSF_SIZE_CLASS_STATS == 1 )
+    {
+        xSizeClassStats[ uxFLIndex ].xNumberOfFreeBlocks--;
+        xSizeClassStats[ uxFLIndex ].xFreeBytes -= heapBLOCK_SIZE( pxBlock );
+    }
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+static void prvTrimBlock( BlockHeader_t * pxBlock,
+                          size_t xSize )
+{
+    BlockHeader_t * pxRemainder;
+    size_t xBlockSize = heapBLOCK_SIZE( pxBlock );
+
+    if( ( xBlockSize - xSize ) >= ( xHeapStructSize + xMinimumPayloadSize ) )
+    {
+        pxRemainder = ( BlockHeader_t * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize + xSize );
+        pxRemainder->pxPrevPhysBlock = pxBlock;
+        pxRemainder->xBlockSize = xBlockSize - xSize - xHeapStructSize;
+        heapNEXT_PHYS_BLOCK( pxRemainder )->pxPrevPhysBlock = pxRemainder;
+
+        pxBlock->xBlockSize = xSize;
+
+        /* The remainder cannot be next to another free block, as the block
+         * it was split from was free and free blocks are always coalesced. */
+        prvInsertFreeBlock( pxRemainder );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvMergeWithNext( BlockHeader_t * pxBlock,
+                              BlockHeader_t * pxNext )
+{
+    pxBlock->xBlockSize += xHeapStructSize + heapBLOCK_SIZE( pxNext );
+    heapNEXT_PHYS_BLOCK( pxBlock )->pxPrevPhysBlock = pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+static void prvAddRegion( uint8_t * pucStartAddress,
+                          size_t xSizeInBytes )
+{
+    BlockHeader_t * pxFirstBlock;
+    BlockHeader_t * pxEndMarker;
+    size_t xAddress = ( size_t ) pucStartAddress;
+    size_t xEndAddress;
+
+    /* Ensure the region starts and ends on correctly aligned boundaries. */
+    xEndAddress = xAddress + xSizeInBytes;
+    xAddress = ( xAddress + heapGRANULARITY_MASK ) & ~heapGRANULARITY_MASK;
+    xEndAddress &= ~heapGRANULARITY_MASK;
+
+    /* The region needs room for at least one minimum sized block and the end
+     * marker. */
+    if( ( xEndAddress > xAddress ) &&
+        ( ( xEndAddress - xAddress ) >= ( ( 2U * xHeapStructSize ) + xMinimumPayloadSize ) ) )
+    {
+        pxFirstBlock = ( BlockHeader_t * ) xAddress;
+        pxFirstBlock->pxPrevPhysBlock = NULL;
+        pxFirstBlock->xBlockSize = ( xEndAddress - xAddress ) - ( 2U * xHeapStructSize );
+
+        /* Memory beyond the largest size class cannot be managed. */
+        if( pxFirstBlock->xBlockSize > heapMAXIMUM_BLOCK_SIZE )
+        {
+            pxFirstBlock->xBlockSize = heapMAXIMUM_BLOCK_SIZE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* A zero sized block that is never free marks the end of the region
+         * so blocks are not coalesced across regions. */
+        pxEndMarker = heapNEXT_PHYS_BLOCK( pxFirstBlock );
+        pxEndMarker->pxPrevPhysBlock = pxFirstBlock;
+        pxEndMarker->xBlockSize = 0U;
+
+        #if ( heapTLSF_SIZE_CLASS_STATS == 1 )
+        {
+            UBaseType_t uxFLIndex;
+
+            for( uxFLIndex = 0U; uxFLIndex < heapTLSF_FL_INDEX_COUNT; uxFLIndex++ )
+            {
+                xSizeClassStats[ uxFLIndex ].xMinimumBlockSizeInBytes = ( uxFLIndex == 0U ) ? 0U :
+                                                                      ( ( size_t ) 1 << ( heapFL_INDEX_SHIFT + uxFLIndex - 1U ) );
+            }
+        }
+        #endif
+
+        prvInsertFreeBlock( pxFirstBlock );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void ) /* PRIVILEGED_FUNCTION */
+{
+    /* Allocate the memory for the heap. */
+    #if ( configAPPLICATION_ALLOCATED_HEAP == 1 )
+
+        /* The application writer has already defined the array used for the RTOS
+        * heap - probably so it can be placed in a special segment or address. */
+        extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+    #else
+        PRIVILEGED_DATA static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+    #endif /* configAPPLICATION_ALLOCATED_HEAP */
+
+    prvAddRegion( ucHeap, configTOTAL_HEAP_SIZE );
+
+    xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+    xHeapHasBeenInitialised = pdTRUE;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,92 @@
+/*
+ * FreeRTOS V202212.00
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Configuration and size class statistics for heap_tlsf.c.
+ */
+
+#ifndef HEAP_TLSF_H
+#define HEAP_TLSF_H
+
+#include "FreeRTOS.h"
+
+/* Log2 of the number of second level lists each first level (power of two)
+ * size range is split into.  Larger values waste less memory on rounding
+ * requests up to a size class at the cost of a larger control structure. */
+#ifndef heapTLSF_SL_INDEX_COUNT_LOG2
+    #define heapTLSF_SL_INDEX_COUNT_LOG2    4
+#endif
+
+/* Number of first level size ranges.  The largest block the heap can manage
+ * is 2^( heapTLSF_FL_INDEX_COUNT + heapTLSF_SL_INDEX_COUNT_LOG2 +
+ * log2( portBYTE_ALIGNMENT ) - 1 ) bytes.  Must not exceed 32. */
+#ifndef heapTLSF_FL_INDEX_COUNT
+    #define heapTLSF_FL_INDEX_COUNT    24
+#endif
+
+/* Set to 1 to keep per size class counters that can be read with
+ * vPortGetHeapSizeClassStats(). */
+#ifndef heapTLSF_SIZE_CLASS_STATS
+    #define heapTLSF_SIZE_CLASS_STATS    0
+#endif
+
+/* Set to 1 to build xPortCheckHeapIntegrity(). */
+#ifndef heapTLSF_INTEGRITY_CHECK
+    #define heapTLSF_INTEGRITY_CHECK    0
+#endif
+
+#if ( heapTLSF_SIZE_CLASS_STATS == 1 )
+
+/* Counters for one first level size range. */
+    typedef struct xHeapSizeClassStats
+    {
+        size_t xMinimumBlockSizeInBytes;     /* Smallest block size that falls in this size range. */
+        size_t xNumberOfFreeBlocks;          /* Free blocks currently in this size range. */
+        size_t xFreeBytes;                   /* Bytes held by those free blocks. */
+        size_t xNumberOfSuccessfulAllocations; /* Allocations served from this size range since boot. */
+    } HeapSizeClassStats_t;
+
+/*
+ * Copies the counters of every first level size range into pxStats, which
+ * must have room for heapTLSF_FL_INDEX_COUNT entries.
+ */
+    void vPortGetHeapSizeClassStats( HeapSizeClassStats_t * pxStats );
+#endif /* heapTLSF_SIZE_CLASS_STATS */
+
+#if ( heapTLSF_INTEGRITY_CHECK == 1 )
+
+/*
+ * Walks every free list and checks that each block is linked correctly, is on
+ * the list for its size and is coalesced with its neighbours, and that the
+ * free byte and block counts reported by vPortGetHeapStats() (and by
+ * vPortGetHeapSizeClassStats() if enabled) match the lists.  Takes time
+ * proportional to the number of free blocks, so is meant for tests.  Returns
+ * pdPASS if the heap is consistent, otherwise pdFAIL.
+ */
+    BaseType_t xPortCheckHeapIntegrity( void );
+#endif /* heapTLSF_INTEGRITY_CHECK */
+
+#endif /* HEAP_TLSF_H */
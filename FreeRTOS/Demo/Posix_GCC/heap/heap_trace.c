@@ -0,0 +1,93 @@
+/*
+ * FreeRTOS V202212.00
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Allocation trace recorder for the Posix demo.  See heap_trace.h.
+ */
+
+#include <stdio.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+
+#if ( projRECORD_HEAP_TRACE == 1 )
+
+/* The allocation functions are called with the scheduler suspended, or before
+ * it starts, so only one thread writes to the file at a time. */
+    static FILE * pxTraceFile = NULL;
+    static BaseType_t xTraceStopped = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvOpenTraceFile( void )
+    {
+        if( ( pxTraceFile == NULL ) && ( xTraceStopped == pdFALSE ) )
+        {
+            pxTraceFile = fopen( heaptraceFILE_NAME, "w" );
+
+            if( pxTraceFile == NULL )
+            {
+                /* Do not try again on every allocation. */
+                xTraceStopped = pdTRUE;
+            }
+        }
+
+        return ( pxTraceFile != NULL ) ? pdTRUE : pdFALSE;
+    }
+/*-----------------------------------------------------------*/
+
+    void vHeapTraceMalloc( void * pvAddress,
+                           size_t xSize )
+    {
+        /* Failed allocations do not change the heap, so are not recorded. */
+        if( ( pvAddress != NULL ) && ( prvOpenTraceFile() == pdTRUE ) )
+        {
+            ( void ) fprintf( pxTraceFile, "m %lx %lu\n", ( unsigned long ) ( uintptr_t ) pvAddress, ( unsigned long ) xSize );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vHeapTraceFree( void * pvAddress )
+    {
+        if( ( pvAddress != NULL ) && ( prvOpenTraceFile() == pdTRUE ) )
+        {
+            ( void ) fprintf( pxTraceFile, "f %lx\n", ( unsigned long ) ( uintptr_t ) pvAddress );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vHeapTraceStop( void )
+    {
+        xTraceStopped = pdTRUE;
+
+        if( pxTraceFile != NULL )
+        {
+            ( void ) fclose( pxTraceFile );
+            pxTraceFile = NULL;
+        }
+    }
+
+#endif /* projRECORD_HEAP_TRACE */
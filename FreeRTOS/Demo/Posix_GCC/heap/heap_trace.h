@@ -0,0 +1,61 @@
+/*
+ * FreeRTOS V202212.00
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Records every pvPortMalloc() and vPortFree() call made by the demo to a text
+ * file that heap_bench.c can replay against each heap implementation.  Each
+ * successful allocation is written as "m <address> <size>" and each free of a
+ * non NULL pointer as "f <address>", with the address in hexadecimal.
+ *
+ * This header is included from FreeRTOSConfig.h.  The sizes recorded are those
+ * passed to traceMALLOC(), which are the sizes the application requested when
+ * the demo is built with the default heap_3.c, so record traces with that
+ * build.
+ */
+
+#ifndef HEAP_TRACE_H
+#define HEAP_TRACE_H
+
+#include <stddef.h>
+
+/* The file written to the current directory. */
+#ifndef heaptraceFILE_NAME
+    #define heaptraceFILE_NAME    "HeapTrace.txt"
+#endif
+
+void vHeapTraceMalloc( void * pvAddress,
+                       size_t xSize );
+void vHeapTraceFree( void * pvAddress );
+
+/*
+ * Flushes and closes the trace file.  Events recorded afterwards are dropped.
+ */
+void vHeapTraceStop( void );
+
+#define traceMALLOC( pvAddress, uiSize )    vHeapTraceMalloc( ( pvAddress ), ( size_t ) ( uiSize ) )
+#define traceFREE( pvAddress, uiSize )      vHeapTraceFree( pvAddress )
+
+#endif /* HEAP_TRACE_H */
@@ -36,6 +36,9 @@
  * If mainSELECTED_APPLICATION = FULL_DEMO the more comprehensive test and demo
  * application built. This is implemented and described in main_full.c.
  *
+ * If mainSELECTED_APPLICATION = BENCHMARK_DEMO a set of kernel micro-benchmarks
+ * is run instead. This is implemented and described in main_benchmark.c.
+ *
  * This file implements the code that is not demo specific, including the
  * hardware setup and FreeRTOS hook functions.
  *
@@ -73,8 +76,9 @@
     #include <trcRecorder.h>
 #endif
 
-#define    BLINKY_DEMO    0
-#define    FULL_DEMO      1
+#define    BLINKY_DEMO       0
+#define    FULL_DEMO         1
+#define    BENCHMARK_DEMO    2
 
 #ifdef BUILD_DIR
     #define BUILD         BUILD_DIR
@@ -82,6 +86,10 @@
     #define BUILD         "./"
 #endif
 
+/* File the ring tracer writes to, decode it with
+ * Ring_Trace/ring_trace_decode.py. */
+#define mainRING_TRACE_FILE    "RingTrace.bin"
+
 /* Demo type is passed as an argument */
 #ifdef USER_DEMO
     #define     mainSELECTED_APPLICATION    USER_DEMO
@@ -89,12 +97,14 @@
     #define    mainSELECTED_APPLICATION     FULL_DEMO
 #endif
 
-/* This demo uses heap_3.c (the libc provided malloc() and free()). */
+/* This demo uses heap_3.c (the libc provided malloc() and free()), or
+ * heap/heap_tlsf.c when built with HEAP=TLSF. */
 
 /*-----------------------------------------------------------*/
 
 extern void main_blinky( void );
 extern void main_full( void );
+extern void main_benchmark( void );
 static void traceOnEnter( void );
 
 /*
@@ -130,6 +140,16 @@ void vApplicationGetTimerTaskMemory( StaticTask_t ** ppxTimerTaskTCBBuffer,
 
 #endif /* if ( projENABLE_TRACING == 1 ) */
 
+#if ( projENABLE_RING_TRACE == 1 )
+
+    /*
+     * Writes the ring trace buffers to mainRING_TRACE_FILE, see
+     * Ring_Trace/ring_trace.h.
+     */
+    static void prvSaveRingTraceFile( void );
+
+#endif /* if ( projENABLE_RING_TRACE == 1 ) */
+
 /*
  * Signal handler for Ctrl_C to cause the program to exit, and generate the
  * profiling info.
@@ -168,6 +188,15 @@ int main( void )
     }
     #endif /* if ( projENABLE_TRACING == 1 ) */
 
+    #if ( projENABLE_RING_TRACE == 1 )
+    {
+        vRingTraceStart();
+
+        printf( "\r\nRing trace started.\r\nThe trace will be written to %s if a call to configASSERT() fails or Ctrl_C is hit.\r\n",
+                mainRING_TRACE_FILE );
+    }
+    #endif /* if ( projENABLE_RING_TRACE == 1 ) */
+
     console_init();
     #if ( mainSELECTED_APPLICATION == BLINKY_DEMO )
     {
@@ -179,6 +208,11 @@ int main( void )
         console_print( "Starting full demo\n" );
         main_full();
     }
+    #elif ( mainSELECTED_APPLICATION == BENCHMARK_DEMO )
+    {
+        console_print( "Starting kernel benchmark\n" );
+        main_benchmark();
+    }
     #else
     {
         #error "The selected demo is not valid"
@@ -289,6 +323,12 @@ void traceOnEnter( void )
             }
             #endif /* if ( projENABLE_TRACING == 1 ) */
 
+            #if ( projENABLE_RING_TRACE == 1 )
+            {
+                prvSaveRingTraceFile();
+            }
+            #endif /* if ( projENABLE_RING_TRACE == 1 ) */
+
             /* clear the buffer */
             char buffer[ 1 ];
             read( STDIN_FILENO, &buffer, 1 );
@@ -346,6 +386,18 @@ void vAssertCalled( const char * const pcFileName,
                 prvSaveTraceFile();
             }
             #endif /* if ( projENABLE_TRACING == 0 ) */
+
+            #if ( projENABLE_RING_TRACE == 1 )
+            {
+                prvSaveRingTraceFile();
+            }
+            #endif /* if ( projENABLE_RING_TRACE == 1 ) */
+
+            #if ( projRECORD_HEAP_TRACE == 1 )
+            {
+                vHeapTraceStop();
+            }
+            #endif /* if ( projRECORD_HEAP_TRACE == 1 ) */
         }
 
         /* You can step out of this function to debug the assertion by using
@@ -388,6 +440,24 @@ void vAssertCalled( const char * const pcFileName,
 
 /*-----------------------------------------------------------*/
 
+#if ( projENABLE_RING_TRACE == 1 )
+
+    static void prvSaveRingTraceFile( void )
+    {
+        if( xRingTraceDump( mainRING_TRACE_FILE ) == 0 )
+        {
+            printf( "\r\nRing trace saved to %s\r\n", mainRING_TRACE_FILE );
+        }
+        else
+        {
+            printf( "\r\nFailed to create ring trace file\r\n" );
+        }
+    }
+
+#endif /* if ( projENABLE_RING_TRACE == 1 ) */
+
+/*-----------------------------------------------------------*/
+
 /* configUSE_STATIC_ALLOCATION is set to 1, so the application must provide an
  * implementation of vApplicationGetIdleTaskMemory() to provide the memory that is
  * used by the Idle task. */
@@ -456,6 +526,19 @@ void handle_sigint( int signal )
         printf( "chdir into %s error is %d\n", BUILD, errno );
     }
 
+    #if ( projENABLE_RING_TRACE == 1 )
+    {
+        prvSaveRingTraceFile();
+    }
+    #endif /* if ( projENABLE_RING_TRACE == 1 ) */
+
+    #if ( projRECORD_HEAP_TRACE == 1 )
+    {
+        vHeapTraceStop();
+        printf( "\r\nHeap trace saved to %s\r\n", heaptraceFILE_NAME );
+    }
+    #endif /* if ( projRECORD_HEAP_TRACE == 1 ) */
+
     _exit( 2 );
 }
 
@@ -0,0 +1,629 @@
+/*
+ * FreeRTOS V202212.00
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/******************************************************************************
+ * NOTE 1: The FreeRTOS demo threads will not be running continuously, so
+ * do not expect to get real time behaviour from the FreeRTOS Linux port, or
+ * this demo application.  The absolute numbers produced by this benchmark
+ * include the cost of the Linux threads that simulate FreeRTOS tasks, so they
+ * are only meaningful when compared with other runs on the same host.
+ *
+ * NOTE 2:  This file only contains the source code that is specific to the
+ * benchmark.  Generic functions, such FreeRTOS hook functions, are defined
+ * in main.c.
+ ******************************************************************************
+ *
+ * main_benchmark() creates a controller task and starts the scheduler.  The
+ * controller runs each of the following micro-benchmarks in turn, then exits
+ * the process:
+ *
+ * - context_switch: two tasks of equal priority calling taskYIELD().
+ * - semaphore_handoff: two tasks passing control back and forth through a
+ *   pair of binary semaphores.
+ * - notify_handoff: as above, but using direct to task notifications.
+ * - queue_transfer: one task sending to and one task receiving from a queue,
+ *   for a range of item sizes.
+ * - stream_buffer_transfer and message_buffer_transfer: as above, for a range
+ *   of chunk sizes.
+ * - timer_start_stop: starting and stopping software timers, which includes a
+ *   round trip through the timer command queue.
+ * - timer_expire: the timer task processing expired timers and calling their
+ *   callbacks.  Timers that fall due on the same tick are timed from the first
+ *   callback to the last, so the wait for the tick itself is not included.
+ * - malloc_free: freeing and reallocating blocks held in a window of live
+ *   allocations, for a range of sizes.
+ *
+ * Each result is written to stdout as one line of JSON, for example:
+ *
+ * {"benchmark":"queue_transfer","parameter":16,"iterations":10000,"ns_per_op":812.4,"max_ns":0,"cores":1}
+ *
+ * where parameter is the item, chunk or block size where one applies, and
+ * max_ns is the slowest single operation where it is measured.  For the
+ * benchmarks that pass control between two tasks an operation is one switch
+ * from one task to the other, so a round trip takes two.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "timers.h"
+#include "stream_buffer.h"
+#include "message_buffer.h"
+
+/* Number of operations timed by each benchmark. */
+#ifndef benchITERATIONS
+    #define benchITERATIONS    ( 10000UL )
+#endif
+
+/* The controller runs below the benchmark tasks so it only measures the end
+ * time once both of them have finished. */
+#define benchCONTROLLER_PRIORITY    ( tskIDLE_PRIORITY + 1 )
+#define benchHELPER_PRIORITY        ( tskIDLE_PRIORITY + 2 )
+
+/* Length of the queues and size of the buffers being benchmarked. */
+#define benchQUEUE_LENGTH           ( 16 )
+#define benchBUFFER_SIZE_BYTES      ( 4096 )
+
+/* Largest item, chunk or block size used by any benchmark. */
+#define benchMAX_ITEM_SIZE          ( 256 )
+
+/* Number of software timers cycled through by timer_start_stop, and armed to
+ * expire together by each round of timer_expire. */
+#define benchTIMER_COUNT            ( 32 )
+
+/* Number of blocks kept allocated by malloc_free. */
+#define benchMALLOC_WINDOW          ( 64 )
+
+#ifndef configNUMBER_OF_CORES
+    #define configNUMBER_OF_CORES    1
+#endif
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The controller task as described in the comments at the top of this file.
+ */
+static void prvBenchmarkControllerTask( void * pvParameters );
+
+/*
+ * Start pxFirst and pxSecond at the same time, wait for both to finish and
+ * return the time taken in nanoseconds.
+ */
+static uint64_t prvRunPair( TaskFunction_t pxFirst,
+                            TaskFunction_t pxSecond );
+
+/*
+ * Called by a benchmark task when its loop completes.
+ */
+static void prvHelperDone( void );
+
+/*
+ * Write one result line.
+ */
+static void prvReport( const char * pcBenchmark,
+                       uint32_t ulParameter,
+                       uint64_t ullElapsedNs,
+                       uint64_t ullMaxNs );
+
+/*
+ * The benchmarks.
+ */
+static void prvBenchmarkTimers( void );
+static void prvBenchmarkMalloc( void );
+
+/*
+ * Tasks used by the benchmarks that need two tasks.
+ */
+static void prvYieldTask( void * pvParameters );
+static void prvSemaphorePingTask( void * pvParameters );
+static void prvSemaphorePongTask( void * pvParameters );
+static void prvNotifyPingTask( void * pvParameters );
+static void prvNotifyPongTask( void * pvParameters );
+static void prvQueueSendTask( void * pvParameters );
+static void prvQueueReceiveTask( void * pvParameters );
+static void prvStreamBufferSendTask( void * pvParameters );
+static void prvStreamBufferReceiveTask( void * pvParameters );
+static void prvMessageBufferSendTask( void * pvParameters );
+static void prvMessageBufferReceiveTask( void * pvParameters );
+
+static void prvTimerCallback( TimerHandle_t xTimer );
+static void prvExpiryCallback( TimerHandle_t xTimer );
+
+/*-----------------------------------------------------------*/
+
+/* Item, chunk and block sizes each transfer benchmark is run with. */
+static const uint32_t ulItemSizes[] = { 4, 16, 64, benchMAX_ITEM_SIZE };
+
+static TaskHandle_t xControllerTask = NULL;
+static TaskHandle_t xFirstTask = NULL;
+static TaskHandle_t xSecondTask = NULL;
+
+/* The objects the benchmark tasks operate on, and the size of the items they
+ * transfer. */
+static SemaphoreHandle_t xPingSemaphore = NULL;
+static SemaphoreHandle_t xPongSemaphore = NULL;
+static QueueHandle_t xQueue = NULL;
+static StreamBufferHandle_t xStreamBuffer = NULL;
+static MessageBufferHandle_t xMessageBuffer = NULL;
+static uint32_t ulItemSize = 0;
+
+/* Written by prvExpiryCallback() in the timer task. */
+static uint32_t ulExpiredTimers = 0;
+static uint64_t ullFirstExpiryNs = 0;
+static uint64_t ullLastExpiryNs = 0;
+
+/*-----------------------------------------------------------*/
+
+/*** SEE THE COMMENTS AT THE TOP OF THIS FILE ***/
+void main_benchmark( void )
+{
+    xTaskCreate( prvBenchmarkControllerTask,
+                 "BenchCtrl",
+                 configMINIMAL_STACK_SIZE,
+                 NULL,
+                 benchCONTROLLER_PRIORITY,
+                 &xControllerTask );
+
+    vTaskStartScheduler();
+
+    /* If all is well, the scheduler will now be running, and the following
+     * line will never be reached.  If the following line does execute, then
+     * there was insufficient FreeRTOS heap memory available for the idle and/or
+     * timer tasks to be created. */
+    for( ; ; )
+    {
+    }
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvNowNs( void )
+{
+    struct timespec xNow;
+
+    clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+    return ( uint64_t ) xNow.tv_sec * 1000000000ULL + ( uint64_t ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReport( const char * pcBenchmark,
+                       uint32_t ulParameter,
+                       uint64_t ullElapsedNs,
+                       uint64_t ullMaxNs )
+{
+    printf( "{\"benchmark\":\"%s\",\"parameter\":%lu,\"iterations\":%lu,\"ns_per_op\":%.1f,\"max_ns\":%llu,\"cores\":%d}\r\n",
+            pcBenchmark,
+            ( unsigned long ) ulParameter,
+            ( unsigned long ) benchITERATIONS,
+            ( double ) ullElapsedNs / ( double ) benchITERATIONS,
+            ( unsigned long long ) ullMaxNs,
+            ( int ) configNUMBER_OF_CORES );
+    fflush( stdout );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkControllerTask( void * pvParameters )
+{
+    size_t x;
+    uint64_t ullElapsedNs;
+
+    ( void ) pvParameters;
+
+    /* Both tasks yield once per iteration, and the ping pong benchmarks make a
+     * round trip per iteration, so each is two switches between the tasks. */
+    ullElapsedNs = prvRunPair( prvYieldTask, prvYieldTask );
+    prvReport( "context_switch", 0, ullElapsedNs / 2U, 0 );
+
+    xPingSemaphore = xSemaphoreCreateBinary();
+    xPongSemaphore = xSemaphoreCreateBinary();
+    configASSERT( ( xPingSemaphore != NULL ) && ( xPongSemaphore != NULL ) );
+    ullElapsedNs = prvRunPair( prvSemaphorePingTask, prvSemaphorePongTask );
+    prvReport( "semaphore_handoff", 0, ullElapsedNs / 2U, 0 );
+    vSemaphoreDelete( xPingSemaphore );
+    vSemaphoreDelete( xPongSemaphore );
+
+    ullElapsedNs = prvRunPair( prvNotifyPingTask, prvNotifyPongTask );
+    prvReport( "notify_handoff", 0, ullElapsedNs / 2U, 0 );
+
+    for( x = 0; x < ( sizeof( ulItemSizes ) / sizeof( ulItemSizes[ 0 ] ) ); x++ )
+    {
+        ulItemSize = ulItemSizes[ x ];
+
+        xQueue = xQueueCreate( benchQUEUE_LENGTH, ulItemSize );
+        configASSERT( xQueue != NULL );
+        prvReport( "queue_transfer", ulItemSize, prvRunPair( prvQueueSendTask, prvQueueReceiveTask ), 0 );
+        vQueueDelete( xQueue );
+
+        xStreamBuffer = xStreamBufferCreate( benchBUFFER_SIZE_BYTES, 1 );
+        configASSERT( xStreamBuffer != NULL );
+        prvReport( "stream_buffer_transfer", ulItemSize, prvRunPair( prvStreamBufferSendTask, prvStreamBufferReceiveTask ), 0 );
+        vStreamBufferDelete( xStreamBuffer );
+
+        xMessageBuffer = xMessageBufferCreate( benchBUFFER_SIZE_BYTES );
+        configASSERT( xMessageBuffer != NULL );
+        prvReport( "message_buffer_transfer", ulItemSize, prvRunPair( prvMessageBufferSendTask, prvMessageBufferReceiveTask ), 0 );
+        vMessageBufferDelete( xMessageBuffer );
+    }
+
+    prvBenchmarkTimers();
+    prvBenchmarkMalloc();
+
+    printf( "Benchmarks complete\r\n" );
+    exit( 0 );
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvRunPair( TaskFunction_t pxFirst,
+                            TaskFunction_t pxSecond )
+{
+    uint64_t ullStartNs;
+    uint32_t ulFinished = 0;
+
+    /* Create both tasks with the scheduler suspended so neither can start
+     * before the other exists. */
+    vTaskSuspendAll();
+    {
+        xTaskCreate( pxFirst, "BenchA", configMINIMAL_STACK_SIZE, NULL, benchHELPER_PRIORITY, &xFirstTask );
+        xTaskCreate( pxSecond, "BenchB", configMINIMAL_STACK_SIZE, NULL, benchHELPER_PRIORITY, &xSecondTask );
+        configASSERT( ( xFirstTask != NULL ) && ( xSecondTask != NULL ) );
+
+        ullStartNs = prvNowNs();
+    }
+    ( void ) xTaskResumeAll();
+
+    while( ulFinished < 2U )
+    {
+        ulFinished += ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+    }
+
+    return prvNowNs() - ullStartNs;
+}
+/*-----------------------------------------------------------*/
+
+static void prvHelperDone( void )
+{
+    xTaskNotifyGive( xControllerTask );
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvYieldTask( void * pvParameters )
+{
+    uint32_t ul;
+
+    ( void ) pvParameters;
+
+    for( ul = 0; ul < benchITERATIONS; ul++ )
+    {
+        taskYIELD();
+    }
+
+    prvHelperDone();
+}
+/*-----------------------------------------------------------*/
+
+static void prvSemaphorePingTask( void * pvParameters )
+{
+    uint32_t ul;
+
+    ( void ) pvParameters;
+
+    for( ul = 0; ul < benchITERATIONS; ul++ )
+    {
+        xSemaphoreGive( xPingSemaphore );
+        xSemaphoreTake( xPongSemaphore, portMAX_DELAY );
+    }
+
+    prvHelperDone();
+}
+/*-----------------------------------------------------------*/
+
+static void prvSemaphorePongTask( void * pvParameters )
+{
+    uint32_t ul;
+
+    ( void ) pvParameters;
+
+    for( ul = 0; ul < benchITERATIONS; ul++ )
+    {
+        xSemaphoreTake( xPingSemaphore, portMAX_DELAY );
+        xSemaphoreGive( xPongSemaphore );
+    }
+
+    prvHelperDone();
+}
+/*-----------------------------------------------------------*/
+
+static void prvNotifyPingTask( void * pvParameters )
+{
+    uint32_t ul;
+
+    ( void ) pvParameters;
+
+    for( ul = 0; ul < benchITERATIONS; ul++ )
+    {
+        xTaskNotifyGive( xSecondTask );
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+    }
+
+    prvHelperDone();
+}
+/*-----------------------------------------------------------*/
+
+static void prvNotifyPongTask( void * pvParameters )
+{
+    uint32_t ul;
+
+    ( void ) pvParameters;
+
+    for( ul = 0; ul < benchITERATIONS; ul++ )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        xTaskNotifyGive( xFirstTask );
+    }
+
+    prvHelperDone();
+}
+/*-----------------------------------------------------------*/
+
+static void prvQueueSendTask( void * pvParameters )
+{
+    uint8_t ucItem[ benchMAX_ITEM_SIZE ] = { 0 };
+    uint32_t ul;
+
+    ( void ) pvParameters;
+
+    for( ul = 0; ul < benchITERATIONS; ul++ )
+    {
+        xQueueSend( xQueue, ucItem, portMAX_DELAY );
+    }
+
+    prvHelperDone();
+}
+/*-----------------------------------------------------------*/
+
+static void prvQueueReceiveTask( void * pvParameters )
+{
+    uint8_t ucItem[ benchMAX_ITEM_SIZE ];
+    uint32_t ul;
+
+    ( void ) pvParameters;
+
+    for( ul = 0; ul < benchITERATIONS; ul++ )
+    {
+        xQueueReceive( xQueue, ucItem, portMAX_DELAY );
+    }
+
+    prvHelperDone();
+}
+/*-----------------------------------------------------------*/
+
+static void prvStreamBufferSendTask( void * pvParameters )
+{
+    uint8_t ucChunk[ benchMAX_ITEM_SIZE ] = { 0 };
+    uint32_t ul;
+
+    ( void ) pvParameters;
+
+    for( ul = 0; ul < benchITERATIONS; ul++ )
+    {
+        ( void ) xStreamBufferSend( xStreamBuffer, ucChunk, ulItemSize, portMAX_DELAY );
+    }
+
+    prvHelperDone();
+}
+/*-----------------------------------------------------------*/
+
+static void prvStreamBufferReceiveTask( void * pvParameters )
+{
+    uint8_t ucChunk[ benchMAX_ITEM_SIZE ];
+    uint64_t ullBytesRemaining = ( uint64_t ) ulItemSize * benchITERATIONS;
+
+    ( void ) pvParameters;
+
+    /* A stream buffer does not preserve chunk boundaries, so receive until
+     * every byte sent has arrived. */
+    while( ullBytesRemaining > 0U )
+    {
+        ullBytesRemaining -= xStreamBufferReceive( xStreamBuffer, ucChunk, sizeof( ucChunk ), portMAX_DELAY );
+    }
+
+    prvHelperDone();
+}
+/*-----------------------------------------------------------*/
+
+static void prvMessageBufferSendTask( void * pvParameters )
+{
+    uint8_t ucMessage[ benchMAX_ITEM_SIZE ] = { 0 };
+    uint32_t ul;
+
+    ( void ) pvParameters;
+
+    for( ul = 0; ul < benchITERATIONS; ul++ )
+    {
+        ( void ) xMessageBufferSend( xMessageBuffer, ucMessage, ulItemSize, portMAX_DELAY );
+    }
+
+    prvHelperDone();
+}
+/*-----------------------------------------------------------*/
+
+static void prvMessageBufferReceiveTask( void * pvParameters )
+{
+    uint8_t ucMessage[ benchMAX_ITEM_SIZE ];
+    uint32_t ul;
+
+    ( void ) pvParameters;
+
+    for( ul = 0; ul < benchITERATIONS; ul++ )
+    {
+        ( void ) xMessageBufferReceive( xMessageBuffer, ucMessage, sizeof( ucMessage ), portMAX_DELAY );
+    }
+
+    prvHelperDone();
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( TimerHandle_t xTimer )
+{
+    /* The timers are always stopped before they expire. */
+    ( void ) xTimer;
+}
+/*-----------------------------------------------------------*/
+
+static void prvExpiryCallback( TimerHandle_t xTimer )
+{
+    uint64_t ullNowNs = prvNowNs();
+
+    ( void ) xTimer;
+
+    if( ulExpiredTimers == 0U )
+    {
+        ullFirstExpiryNs = ullNowNs;
+    }
+
+    ulExpiredTimers++;
+
+    if( ulExpiredTimers == benchTIMER_COUNT )
+    {
+        ullLastExpiryNs = ullNowNs;
+        xTaskNotifyGive( xControllerTask );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTimers( void )
+{
+    TimerHandle_t xTimers[ benchTIMER_COUNT ];
+    uint64_t ullStartNs, ullTotalNs = 0;
+    uint32_t ul, ulRound, ulExpiries = 0;
+
+    for( ul = 0; ul < benchTIMER_COUNT; ul++ )
+    {
+        xTimers[ ul ] = xTimerCreate( "BenchTmr", pdMS_TO_TICKS( 60000UL ), pdFALSE, NULL, prvTimerCallback );
+        configASSERT( xTimers[ ul ] != NULL );
+    }
+
+    /* The timer task runs at a higher priority than this task, so each
+     * command is processed before the call that sent it returns. */
+    ullStartNs = prvNowNs();
+
+    for( ul = 0; ul < benchITERATIONS; ul++ )
+    {
+        xTimerStart( xTimers[ ul % benchTIMER_COUNT ], portMAX_DELAY );
+        xTimerStop( xTimers[ ul % benchTIMER_COUNT ], portMAX_DELAY );
+    }
+
+    prvReport( "timer_start_stop", 0, prvNowNs() - ullStartNs, 0 );
+
+    for( ul = 0; ul < benchTIMER_COUNT; ul++ )
+    {
+        xTimerDelete( xTimers[ ul ], portMAX_DELAY );
+        xTimers[ ul ] = xTimerCreate( "BenchExp", 1, pdFALSE, NULL, prvExpiryCallback );
+        configASSERT( xTimers[ ul ] != NULL );
+    }
+
+    for( ulRound = 0; ulRound < ( ( benchITERATIONS + benchTIMER_COUNT - 1U ) / benchTIMER_COUNT ); ulRound++ )
+    {
+        ulExpiredTimers = 0;
+
+        /* Arm every timer straight after a tick, so they all fall due on the
+         * next one. */
+        vTaskDelay( 1 );
+
+        for( ul = 0; ul < benchTIMER_COUNT; ul++ )
+        {
+            xTimerStart( xTimers[ ul ], portMAX_DELAY );
+        }
+
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+        ullTotalNs += ullLastExpiryNs - ullFirstExpiryNs;
+        ulExpiries += benchTIMER_COUNT - 1U;
+    }
+
+    /* Scale to benchITERATIONS expiries, which prvReport() divides by. */
+    prvReport( "timer_expire", 0, ( ullTotalNs * benchITERATIONS ) / ulExpiries, 0 );
+
+    for( ul = 0; ul < benchTIMER_COUNT; ul++ )
+    {
+        xTimerDelete( xTimers[ ul ], portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkMalloc( void )
+{
+    void * pvBlocks[ benchMALLOC_WINDOW ] = { NULL };
+    uint64_t ullStartNs, ullOpNs, ullTotalNs, ullMaxNs;
+    size_t xSize, xBlock;
+    uint32_t ul;
+    size_t x;
+
+    for( x = 0; x < ( sizeof( ulItemSizes ) / sizeof( ulItemSizes[ 0 ] ) ); x++ )
+    {
+        ullTotalNs = 0U;
+        ullMaxNs = 0U;
+
+        for( ul = 0; ul < benchITERATIONS; ul++ )
+        {
+            /* Vary the size within a factor of two of the nominal size so
+             * freed blocks cannot always be reused as they are. */
+            xBlock = ul % benchMALLOC_WINDOW;
+            xSize = ulItemSizes[ x ] + ( ( ul * 7U ) % ulItemSizes[ x ] );
+
+            ullStartNs = prvNowNs();
+            vPortFree( pvBlocks[ xBlock ] );
+            pvBlocks[ xBlock ] = pvPortMalloc( xSize );
+            ullOpNs = prvNowNs() - ullStartNs;
+
+            configASSERT( pvBlocks[ xBlock ] != NULL );
+
+            ullTotalNs += ullOpNs;
+
+            if( ullOpNs > ullMaxNs )
+            {
+                ullMaxNs = ullOpNs;
+            }
+        }
+
+        prvReport( "malloc_free", ulItemSizes[ x ], ullTotalNs, ullMaxNs );
+    }
+
+    for( xBlock = 0; xBlock < benchMALLOC_WINDOW; xBlock++ )
+    {
+        vPortFree( pvBlocks[ xBlock ] );
+        pvBlocks[ xBlock ] = NULL;
+    }
+}
+/*-----------------------------------------------------------*/
@@ -107,6 +107,7 @@
 #include "StreamBufferInterrupt.h"
 #include "MessageBufferAMP.h"
 #include "console.h"
+#include "run-time-stats-utils.h"
 
 /* Priorities at which the tasks are created. */
 #define mainCHECK_TASK_PRIORITY         ( configMAX_PRIORITIES - 2 )
@@ -268,12 +269,14 @@ static void prvCheckTask( void * pvParameters )
 {
     TickType_t xNextWakeTime;
     const TickType_t xCycleFrequency = pdMS_TO_TICKS( 10000UL );
+    RunTimeStatsSnapshot_t xPreviousSnapshot, xSnapshot;
 
     /* Just to remove compiler warning. */
     ( void ) pvParameters;
 
     /* Initialise xNextWakeTime - this only needs to be done once. */
     xNextWakeTime = xTaskGetTickCount();
+    vRunTimeStatsTakeSnapshot( &xPreviousSnapshot );
 
     for( ; ; )
     {
@@ -425,9 +428,15 @@ static void prvCheckTask( void * pvParameters )
             }
         #endif /* configSUPPORT_STATIC_ALLOCATION */
 
-        printf( "%s - tick count %lu \r\n",
+        /* Report how busy the scheduler was since the last check. */
+        vRunTimeStatsTakeSnapshot( &xSnapshot );
+
+        printf( "%s - tick count %lu - busy %lu%% \r\n",
                 pcStatusMessage,
-                xTaskGetTickCount() );
+                xTaskGetTickCount(),
+                ( unsigned long ) ulRunTimeStatsBusyPercent( &xPreviousSnapshot, &xSnapshot ) );
+
+        xPreviousSnapshot = xSnapshot;
 
         if( xErrorCount != 0 )
         {
@@ -32,36 +32,78 @@
  * real time, therefore the run time counter values have no real meaningful
  * units.
  *
- * Also note that it is assumed this demo is going to be used for short periods
- * of time only, and therefore timer overflows are not handled.
+ * The counter is kept in 64 bits, so at nanosecond resolution it does not
+ * overflow for several hundred years.
  */
 
 #include <time.h>
 
 /* FreeRTOS includes. */
 #include <FreeRTOS.h>
+#include <task.h>
+
+#include "run-time-stats-utils.h"
+
+#ifndef configNUMBER_OF_CORES
+    #define configNUMBER_OF_CORES    1
+#endif
 
 /* Time at start of day (in ns). */
-static unsigned long ulStartTimeNs;
+static uint64_t ullStartTimeNs;
 
 /*-----------------------------------------------------------*/
 
-void vConfigureTimerForRunTimeStats( void )
+static uint64_t prvGetTimeNs( void )
 {
     struct timespec xNow;
 
     clock_gettime( CLOCK_MONOTONIC, &xNow );
-    ulStartTimeNs = xNow.tv_sec * 1000000000ul + xNow.tv_nsec;
+
+    return ( uint64_t ) xNow.tv_sec * 1000000000ULL + ( uint64_t ) xNow.tv_nsec;
 }
 /*-----------------------------------------------------------*/
 
-unsigned long ulGetRunTimeCounterValue( void )
+void vConfigureTimerForRunTimeStats( void )
 {
-    struct timespec xNow;
+    ullStartTimeNs = prvGetTimeNs();
+}
+/*-----------------------------------------------------------*/
 
-    /* Time at start. */
-    clock_gettime( CLOCK_MONOTONIC, &xNow );
+configRUN_TIME_COUNTER_TYPE ulGetRunTimeCounterValue( void )
+{
+    return ( configRUN_TIME_COUNTER_TYPE ) ( prvGetTimeNs() - ullStartTimeNs );
+}
+/*-----------------------------------------------------------*/
+
+void vRunTimeStatsTakeSnapshot( RunTimeStatsSnapshot_t * pxSnapshot )
+{
+    /* Read both counters without a context switch in between so they
+     * describe the same instant. */
+    vTaskSuspendAll();
+    {
+        pxSnapshot->ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+        pxSnapshot->ulIdleRunTime = ulTaskGetIdleRunTimeCounter();
+    }
+    ( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulRunTimeStatsBusyPercent( const RunTimeStatsSnapshot_t * pxPrevious,
+                                    const RunTimeStatsSnapshot_t * pxCurrent )
+{
+    configRUN_TIME_COUNTER_TYPE ulTotal, ulIdle;
+    uint32_t ulBusyPercent = 0UL;
+
+    /* Every core accumulates run time, so the capacity of the interval is
+     * its length multiplied by the number of cores. */
+    ulTotal = ( pxCurrent->ulTotalRunTime - pxPrevious->ulTotalRunTime ) * configNUMBER_OF_CORES;
+    ulIdle = pxCurrent->ulIdleRunTime - pxPrevious->ulIdleRunTime;
+
+    if( ( ulTotal > 0U ) && ( ulIdle <= ulTotal ) )
+    {
+        ulBusyPercent = ( uint32_t ) ( ( ( ulTotal - ulIdle ) * 100U ) / ulTotal );
+    }
 
-    return xNow.tv_sec * 1000000000ul + xNow.tv_nsec - ulStartTimeNs;
+    return ulBusyPercent;
 }
 /*-----------------------------------------------------------*/
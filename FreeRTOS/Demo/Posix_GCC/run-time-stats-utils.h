@@ -0,0 +1,60 @@
+/*
+ * FreeRTOS V202212.00
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef RUN_TIME_STATS_UTILS_H
+    #define RUN_TIME_STATS_UTILS_H
+
+    #include <stdint.h>
+
+    #include "FreeRTOS.h"
+
+    #ifdef __cplusplus
+        extern "C" {
+    #endif
+
+/*-----------------------------------------------------------
+* Cheap system load snapshots.
+*----------------------------------------------------------*/
+
+/* Counters read by vRunTimeStatsTakeSnapshot().  Unlike
+ * uxTaskGetSystemState() taking a snapshot does not copy the state of every
+ * task, so it can be called frequently.  The load over an interval is obtained
+ * by comparing two snapshots with ulRunTimeStatsBusyPercent(). */
+    typedef struct RunTimeStatsSnapshot
+    {
+        configRUN_TIME_COUNTER_TYPE ulTotalRunTime; /* portGET_RUN_TIME_COUNTER_VALUE() when the snapshot was taken. */
+        configRUN_TIME_COUNTER_TYPE ulIdleRunTime;  /* Run time accumulated by the idle task of every core. */
+    } RunTimeStatsSnapshot_t;
+
+    void vRunTimeStatsTakeSnapshot( RunTimeStatsSnapshot_t * pxSnapshot );
+    uint32_t ulRunTimeStatsBusyPercent( const RunTimeStatsSnapshot_t * pxPrevious,
+                                        const RunTimeStatsSnapshot_t * pxCurrent );
+
+    #ifdef __cplusplus
+        }
+    #endif
+
+#endif /* RUN_TIME_STATS_UTILS_H */